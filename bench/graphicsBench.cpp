@@ -0,0 +1,410 @@
+// Google Benchmark suite for the engine's hot paths.
+// The simulation and confetti benchmarks need nothing but the CPU. The shader, shape and font benchmarks run
+// against a hidden window's context (GLFW's null platform with OSMesa where available, like --headless) and are
+// skipped if no context can be created.
+//
+// Build with optimizations and write JSON for regression tracking, e.g.
+//   cmake -S . -B build -DCMAKE_BUILD_TYPE=Release && cmake --build build --target graphics_bench
+//   ./build/graphics_bench --benchmark_out=bench.json --benchmark_out_format=json
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <benchmark/benchmark.h>
+
+#include "../src/framework/simulation.h"
+#include "../src/framework/particleSystem.h"
+#include "../src/framework/particleIntegrator.h"
+#include "../src/framework/jobSystem.h"
+#include "../src/framework/shaderManager.h"
+#include "../src/framework/fontRenderer.h"
+#include "../src/framework/streamBuffer.h"
+#include "../src/shapes/circle.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+using std::vector, std::unique_ptr, std::make_unique;
+
+static const vec2 BOUNDS(800, 600);
+static const float DELTA_TIME = 1.0f / 60.0f;
+static const char *FONT_PATH = PROJECT_SOURCE_DIR "/res/fonts/MxPlus_IBM_BIOS.ttf";
+
+/// @brief The hidden window whose context the GL benchmarks use (null if it could not be created)
+static GLFWwindow *window = nullptr;
+
+/// @brief Shader and font shared by the GL benchmarks (loaded once a context exists)
+static unique_ptr<ShaderManager> shaderManager;
+
+/// @brief Creates a hidden window and loads GL, the same way Engine::initWindow() does in headless mode
+static bool createContext() {
+#ifdef GLFW_PLATFORM_NULL
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#endif
+    if (!glfwInit())
+        return false;
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef GLFW_OSMESA_CONTEXT_API
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+#endif
+
+    window = glfwCreateWindow(int(BOUNDS.x), int(BOUNDS.y), "graphics_bench", nullptr, nullptr);
+    if (window == nullptr)
+        return false;
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        glfwDestroyWindow(window);
+        window = nullptr;
+        return false;
+    }
+
+    shaderManager = make_unique<ShaderManager>();
+    shaderManager->loadShader(PROJECT_SOURCE_DIR "/res/shaders/shape.vert", PROJECT_SOURCE_DIR "/res/shaders/shape.frag",
+                              nullptr, "shape");
+    shaderManager->loadShader(PROJECT_SOURCE_DIR "/res/shaders/text.vert", PROJECT_SOURCE_DIR "/res/shaders/text.frag",
+                              nullptr, "text");
+    return true;
+}
+
+/// @brief Skips a GL benchmark when there is no context
+static bool requireContext(benchmark::State &state) {
+    if (window != nullptr)
+        return true;
+    state.SkipWithError("no OpenGL context");
+    return false;
+}
+
+// --------------------------------------------------------
+// Simulation
+// --------------------------------------------------------
+
+/// @brief One fixed tick of the single logo with the move-and-clamp rules
+static void BM_CheckBounds(benchmark::State &state) {
+    Logo logo = {dvec2(BOUNDS.x / 2, BOUNDS.y / 2), dvec2(100, 100), vec2(50, 30)};
+    long long wallsHit = 0, cornersHit = 0;
+    for (auto _ : state) {
+        Simulation::checkBounds(logo, BOUNDS, DELTA_TIME, wallsHit, cornersHit);
+        benchmark::DoNotOptimize(logo);
+    }
+}
+BENCHMARK(BM_CheckBounds);
+
+/// @brief One fixed tick of the single logo with exact time-of-impact stepping
+static void BM_AdvanceExact(benchmark::State &state) {
+    Logo logo = {dvec2(BOUNDS.x / 2, BOUNDS.y / 2), dvec2(100, 100), vec2(50, 30)};
+    long long wallsHit = 0, cornersHit = 0;
+    for (auto _ : state) {
+        Simulation::advanceExact(logo, BOUNDS, DELTA_TIME, wallsHit, cornersHit);
+        benchmark::DoNotOptimize(logo);
+    }
+}
+BENCHMARK(BM_AdvanceExact);
+
+// --------------------------------------------------------
+// Confetti
+// --------------------------------------------------------
+
+/// @brief Fills a pool with count confetti that drift sideways and never fall, so the pool stays full
+static void fillConfetti(ParticleSystem &confetti, size_t count) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> unit(0, 1);
+    for (size_t i = 0; i < count; i++) {
+        vec2 pos(unit(rng) * BOUNDS.x, unit(rng) * BOUNDS.y);
+        vec2 velocity((unit(rng) - 0.5f) * 350.0f, 0);
+        confetti.spawn(pos, velocity, vec2(10, 10), vec4(unit(rng), unit(rng), unit(rng), 1));
+    }
+}
+
+/// @brief ParticleSystem::update() on the calling thread (arg: particles)
+static void BM_ConfettiUpdate(benchmark::State &state) {
+    size_t count = state.range(0);
+    ParticleSystem confetti(count);
+    fillConfetti(confetti, count);
+    for (auto _ : state)
+        confetti.update(DELTA_TIME, 0, nullptr);
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetLabel(getParticleKernelName());
+}
+BENCHMARK(BM_ConfettiUpdate)->Arg(1000)->Arg(10000)->Arg(100000);
+
+/// @brief ParticleSystem::update() spread across the job system (arg: particles)
+static void BM_ConfettiUpdateJobs(benchmark::State &state) {
+    size_t count = state.range(0);
+    ParticleSystem confetti(count);
+    fillConfetti(confetti, count);
+    JobSystem jobs;
+    for (auto _ : state)
+        confetti.update(DELTA_TIME, 0, &jobs);
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetLabel(std::to_string(jobs.getWorkerCount() + 1) + " threads");
+}
+BENCHMARK(BM_ConfettiUpdateJobs)->Arg(1000)->Arg(10000)->Arg(100000)->UseRealTime();
+
+// --------------------------------------------------------
+// Shapes (need a context for the shared geometry)
+// --------------------------------------------------------
+
+/// @brief Circle::bounce() on pairs of overlapping circles moving towards each other (arg: pairs)
+/// @details Only the response; BM_CircleBounceHashed times the same pairs including finding them.
+static void BM_CircleBounce(benchmark::State &state) {
+    if (!requireContext(state))
+        return;
+
+    size_t pairs = state.range(0);
+    Shader shader = shaderManager->getShader("shape");
+    vector<unique_ptr<Circle>> circles;
+    for (size_t i = 0; i < pairs; i++) {
+        circles.push_back(make_unique<Circle>(shader, vec2(0, 0), 10.0f, vec2(0, 0), vec4(1)));
+        circles.push_back(make_unique<Circle>(shader, vec2(0, 0), 15.0f, vec2(0, 0), vec4(1)));
+    }
+
+    for (auto _ : state) {
+        // Put every pair back on a collision course; bounce() separates them and turns them around
+        for (size_t i = 0; i < pairs; i++) {
+            Circle &a = *circles[2 * i], &b = *circles[2 * i + 1];
+            a.setPos(vec2(100, 100));
+            a.setVelocity(vec2(50, 20));
+            b.setPos(vec2(120, 105));
+            b.setVelocity(vec2(-30, 0));
+            a.bounce(b);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * pairs);
+}
+BENCHMARK(BM_CircleBounce)->Arg(1000);
+
+/// @brief The pairs of BM_CircleBounce laid out on a grid and resolved with Circle::resolveCollisions(), so finding
+/// the pairs in the spatial hash is timed along with bouncing them (arg: pairs)
+static void BM_CircleBounceHashed(benchmark::State &state) {
+    if (!requireContext(state))
+        return;
+
+    size_t pairs = state.range(0);
+    size_t columns = size_t(std::ceil(std::sqrt(double(pairs))));
+    Shader shader = shaderManager->getShader("shape");
+    vector<unique_ptr<Circle>> circles;
+    vector<vec2> origins;
+    for (size_t i = 0; i < pairs; i++) {
+        circles.push_back(make_unique<Circle>(shader, vec2(0, 0), 10.0f, vec2(0, 0), vec4(1)));
+        circles.push_back(make_unique<Circle>(shader, vec2(0, 0), 15.0f, vec2(0, 0), vec4(1)));
+        // 100 units apart, so a circle only ever touches its own partner
+        origins.emplace_back(float(i % columns) * 100.0f, float(i / columns) * 100.0f);
+    }
+
+    SpatialHash hash(32.0f);
+    for (auto _ : state) {
+        for (size_t i = 0; i < pairs; i++) {
+            Circle &a = *circles[2 * i], &b = *circles[2 * i + 1];
+            a.setPos(origins[i]);
+            a.setVelocity(vec2(50, 20));
+            b.setPos(origins[i] + vec2(20, 5));
+            b.setVelocity(vec2(-30, 0));
+        }
+        Circle::resolveCollisions(circles, hash);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * pairs);
+}
+BENCHMARK(BM_CircleBounceHashed)->Arg(1000);
+
+/// @brief Checks the hash's candidate pairs against comparing every pair of bounding boxes
+static bool matchesBruteForce(const vector<unique_ptr<Circle>> &circles, SpatialHash &hash) {
+    vector<vec4> boxes;
+    for (const auto &circle : circles)
+        boxes.emplace_back(circle->getLeft(), circle->getRight(), circle->getBottom(), circle->getTop());
+
+    vector<std::pair<unsigned int, unsigned int>> expected;
+    for (unsigned int i = 0; i < boxes.size(); i++) {
+        const vec4 &a = boxes[i];
+        for (unsigned int j = i + 1; j < boxes.size(); j++) {
+            const vec4 &b = boxes[j];
+            if (a.x < b.y && b.x < a.y && a.z < b.w && b.z < a.w)
+                expected.emplace_back(i, j);
+        }
+    }
+
+    vector<std::pair<unsigned int, unsigned int>> found = hash.findPairs();
+    std::sort(expected.begin(), expected.end());
+    std::sort(found.begin(), found.end());
+    return found == expected;
+}
+
+/// @brief A frame of moving circles: move and bounce off the walls, then Circle::resolveCollisions() on a hash kept
+/// from frame to frame (arg: circles, spread out so each has a few neighbors whatever the count)
+static void BM_ResolveCollisions(benchmark::State &state) {
+    if (!requireContext(state))
+        return;
+
+    size_t count = state.range(0);
+    float side = std::sqrt(float(count) * 400.0f);
+    vec2 box(side, side);
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> unit(0, 1);
+    Shader shader = shaderManager->getShader("shape");
+    vector<unique_ptr<Circle>> circles;
+    for (size_t i = 0; i < count; i++) {
+        vec2 pos(unit(rng) * box.x, unit(rng) * box.y);
+        vec2 velocity((unit(rng) - 0.5f) * 200.0f, (unit(rng) - 0.5f) * 200.0f);
+        circles.push_back(make_unique<Circle>(shader, pos, 3.0f + unit(rng) * 4.0f, velocity, vec4(1)));
+    }
+
+    SpatialHash hash(16.0f);
+    for (unsigned int i = 0; i < count; i++)
+        hash.update(i, *circles[i]);
+
+    // The brute-force check is quadratic (seconds at 50k), so only the first run of each count does it
+    static std::set<size_t> checked;
+    if (checked.insert(count).second && !matchesBruteForce(circles, hash)) {
+        state.SkipWithError("spatial hash pairs differ from brute force");
+        return;
+    }
+
+    for (auto _ : state) {
+        for (auto &circle : circles) {
+            vec2 pos = circle->getPos() + circle->getVelocity() * DELTA_TIME;
+            vec2 velocity = circle->getVelocity();
+            for (int axis = 0; axis < 2; axis++) {
+                if ((pos[axis] < 0 && velocity[axis] < 0) || (pos[axis] > box[axis] && velocity[axis] > 0))
+                    velocity[axis] = -velocity[axis];
+            }
+            circle->setPos(pos);
+            circle->setVelocity(velocity);
+        }
+        Circle::resolveCollisions(circles, hash);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["pairs"] = double(hash.findPairs().size());
+}
+BENCHMARK(BM_ResolveCollisions)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+// --------------------------------------------------------
+// Streaming geometry
+// --------------------------------------------------------
+
+/// @brief StreamBuffer::append() with the alignments of different vertex formats mixed in one ring, fencing every few
+/// appends like a renderer flushing its batches (arg: bytes per append)
+/// @details Fails if append() ever returns a region that overlaps one the GPU may still be reading.
+static void BM_StreamBufferAppend(benchmark::State &state) {
+    if (!requireContext(state))
+        return;
+
+    size_t size = state.range(0);
+    const size_t alignments[] = {16, 12, 4, 24, 256};
+    vector<char> data(size);
+    StreamBuffer stream(GL_ARRAY_BUFFER, 64 * 1024);
+    size_t appends = 0;
+    for (auto _ : state) {
+        size_t offset = stream.append(data.data(), size, alignments[appends % 5]);
+        if (stream.overlapsPending(offset, offset + size)) {
+            state.SkipWithError("append() returned a region the GPU may still be reading");
+            break;
+        }
+        if (++appends % 3 == 0)
+            stream.fence();
+    }
+    glFinish();
+    state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_StreamBufferAppend)->Arg(64)->Arg(4096);
+
+// --------------------------------------------------------
+// Shader uniforms
+// --------------------------------------------------------
+
+/// @brief The two setters every shape calls per draw, looked up by name
+static void BM_ShaderSetByName(benchmark::State &state) {
+    if (!requireContext(state))
+        return;
+
+    Shader &shader = shaderManager->getShader("shape");
+    shader.use();
+    mat4 model(1.0f);
+    vec4 color(1, 0.5f, 0.25f, 1);
+    for (auto _ : state) {
+        shader.setMatrix4("model", model);
+        shader.setVector4f("shapeColor", color);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_ShaderSetByName);
+
+/// @brief The same two setters with locations looked up once
+static void BM_ShaderSetByLocation(benchmark::State &state) {
+    if (!requireContext(state))
+        return;
+
+    Shader &shader = shaderManager->getShader("shape");
+    shader.use();
+    GLint modelLocation = shader.getUniformLocation("model");
+    GLint colorLocation = shader.getUniformLocation("shapeColor");
+    mat4 model(1.0f);
+    vec4 color(1, 0.5f, 0.25f, 1);
+    for (auto _ : state) {
+        shader.setMatrix4(modelLocation, model);
+        shader.setVector4f(colorLocation, color);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_ShaderSetByLocation);
+
+// --------------------------------------------------------
+// Text
+// --------------------------------------------------------
+
+/// @brief Loading the font: rasterizing every glyph with FreeType and packing the atlas
+static void BM_FontConstruction(benchmark::State &state) {
+    if (!requireContext(state))
+        return;
+
+    for (auto _ : state) {
+        Font font(FONT_PATH, 24);
+        GLuint atlas = font.getAtlas();
+        glDeleteTextures(1, &atlas); // The caller owns the atlas
+    }
+}
+BENCHMARK(BM_FontConstruction)->Unit(benchmark::kMillisecond);
+
+/// @brief Laying out a HUD-sized string and drawing it (one renderText() and one flush() per frame)
+static void BM_RenderText(benchmark::State &state) {
+    if (!requireContext(state))
+        return;
+
+    FontRenderer fontRenderer(shaderManager->getShader("text"), FONT_PATH, 24);
+    for (auto _ : state) {
+        fontRenderer.renderText("Frame  16.67 ms  min 16.10  avg 16.68  p99 18.20", 8, 580, 0.4f, vec3(1, 1, 0));
+        fontRenderer.flush();
+    }
+    glFinish();
+}
+BENCHMARK(BM_RenderText);
+
+int main(int argc, char **argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    if (!createContext())
+        std::cout << "ERROR::BENCH: Failed to create an OpenGL context; skipping the GL benchmarks" << std::endl;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    // Free the GL objects before the context goes away
+    shaderManager.reset();
+    GeometryCache::clear();
+    if (window != nullptr)
+        glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,135 @@
+// Microbenchmark for the confetti integration step.
+// Compares the original per-object loop (one heap-allocated object per particle, accessed through
+// virtual getters/setters like Rect) against the scalar, SSE and AVX2 structure-of-arrays kernels.
+//
+// Build with optimizations, e.g.
+//   cmake -S . -B build -DCMAKE_BUILD_TYPE=Release && cmake --build build --target particle_bench
+
+#include "../src/framework/particleIntegrator.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+#include <glm/glm.hpp>
+
+using std::vector, std::unique_ptr, std::make_unique, std::cout, std::endl, glm::vec2;
+
+/// @brief Stand-in for Rect without the GL objects: same virtual accessor pattern, one allocation each.
+class ObjectParticle {
+    public:
+        ObjectParticle(vec2 pos, vec2 size, vec2 velocity) : pos(pos), size(size), velocity(velocity) {}
+        virtual ~ObjectParticle() = default;
+
+        virtual vec2 getPos() const { return pos; }
+        virtual vec2 getSize() const { return size; }
+        virtual vec2 getVelocity() const { return velocity; }
+        virtual void setPos(vec2 p) { pos = p; }
+        virtual void setVelocity(vec2 v) { velocity = v; }
+
+    private:
+        vec2 pos, size, velocity;
+};
+
+/// @brief The loop body of the original Engine::checkConfettiBounds(), once per object.
+static bool stepObjects(vector<unique_ptr<ObjectParticle>> &confetti, float deltaTime, float gravity) {
+    bool confettiOnScreen = false;
+    for (auto &c : confetti) {
+        vec2 velocity = c->getVelocity();
+        vec2 position = c->getPos();
+        vec2 size = c->getSize();
+        position += velocity * deltaTime;
+        velocity.y = velocity.y - gravity;
+        if (position.y + (size.y / 2) >= 0)
+            confettiOnScreen = true;
+        c->setVelocity(velocity);
+        c->setPos(position);
+    }
+    return confettiOnScreen;
+}
+
+/// @brief Column copy of the same particles for the kernels.
+struct Columns {
+    vector<float> x, y, velocityX, velocityY, height;
+    vector<unsigned char> alive;
+
+    ParticleArrays arrays() {
+        return {x.data(), y.data(), velocityX.data(), velocityY.data(), height.data(), alive.data()};
+    }
+};
+
+/// @brief Checks that two runs left every column a kernel writes (or could clobber) bit for bit the same.
+static bool sameColumns(const Columns &a, const Columns &b) {
+    auto same = [](const vector<float> &first, const vector<float> &second) {
+        return first.size() == second.size() &&
+               std::memcmp(first.data(), second.data(), first.size() * sizeof(float)) == 0;
+    };
+    return same(a.x, b.x) && same(a.y, b.y) && same(a.velocityX, b.velocityX) && same(a.velocityY, b.velocityY) &&
+           a.alive == b.alive;
+}
+
+template <typename Step>
+static double timeSteps(int steps, Step step) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < steps; i++)
+        step();
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / steps;
+}
+
+int main() {
+    const float deltaTime = 1.0f / 60.0f;
+    const float gravity = 2.0f;
+    const int steps = 200;
+
+    cout << "Selected kernel: " << getParticleKernelName() << endl;
+    cout << "particles, objects (us/step), scalar, sse, avx2" << endl;
+
+    for (size_t count : {1000, 10000, 100000}) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> speed(-175.0f, 175.0f);
+
+        vector<unique_ptr<ObjectParticle>> objects;
+        Columns original;
+        for (size_t i = 0; i < count; i++) {
+            vec2 pos(400.0f, 300.0f), velocity(speed(rng), speed(rng) + 175.0f), size(10.0f, 10.0f);
+            objects.push_back(make_unique<ObjectParticle>(pos, size, velocity));
+            original.x.push_back(pos.x);
+            original.y.push_back(pos.y);
+            original.velocityX.push_back(velocity.x);
+            original.velocityY.push_back(velocity.y);
+            original.height.push_back(size.y);
+        }
+        original.alive.resize(count);
+
+        double objectTime = timeSteps(steps, [&] { stepObjects(objects, deltaTime, gravity); });
+
+        // Run each kernel on its own copy and make sure it lands exactly where the scalar kernel does
+        ParticleKernel kernels[] = {integrateParticlesScalar, integrateParticlesSSE, integrateParticlesAVX2};
+        const char *names[] = {"scalar", "sse", "avx2"};
+        double kernelTimes[3] = {0, 0, 0};
+        Columns reference;
+        for (int k = 0; k < 3; k++) {
+            if (kernels[k] == integrateParticlesAVX2 && getParticleKernel() != integrateParticlesAVX2)
+                continue; // CPU doesn't support AVX2
+
+            Columns columns = original;
+            ParticleArrays arrays = columns.arrays();
+            kernelTimes[k] = timeSteps(steps, [&] { kernels[k](arrays, 0, count, deltaTime, gravity); });
+
+            if (k == 0) {
+                reference = columns;
+            } else if (!sameColumns(columns, reference)) {
+                cout << "ERROR: " << names[k] << " kernel does not match the scalar kernel" << endl;
+                return 1;
+            }
+        }
+
+        cout << count << ", " << objectTime << ", " << kernelTimes[0] << ", " << kernelTimes[1] << ", "
+             << kernelTimes[2] << endl;
+    }
+
+    return 0;
+}
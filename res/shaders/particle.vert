@@ -0,0 +1,29 @@
+#version 330 core
+
+layout (location = 0) in vec2 aPos;
+
+// Per-instance attributes (glVertexAttribDivisor = 1)
+layout (location = 1) in float aX;
+layout (location = 2) in float aY;
+layout (location = 3) in float aWidth;
+layout (location = 4) in float aHeight;
+layout (location = 5) in vec4 aColor;
+
+// Frame-global state shared by every shader (see ShaderManager::updateFrameUniforms)
+layout (std140) uniform Frame
+{
+    mat4 projection;
+    vec2 viewport;
+    float time;
+    float deltaTime;
+};
+
+out vec4 ParticleColor;
+
+void main()
+{
+    // Same transform as shape.vert's model matrix (scale, then translate), built per instance
+    vec2 worldPos = aPos * vec2(aWidth, aHeight) + vec2(aX, aY);
+    ParticleColor = aColor;
+    gl_Position = projection * vec4(worldPos, 0.0, 1.0);
+}
@@ -3,7 +3,14 @@
 layout (location = 0) in vec2 aPos;
 
 uniform mat4 model;
-uniform mat4 projection;
+// Frame-global state shared by every shader (see ShaderManager::updateFrameUniforms)
+layout (std140) uniform Frame
+{
+    mat4 projection;
+    vec2 viewport;
+    float time;
+    float deltaTime;
+};
 
 void main()
 {
@@ -5,7 +5,14 @@ layout (location = 0) in vec4 vertex; // <vec2 position, vec2 texCoords>
 out vec2 TexCoords;
 
 uniform mat4 model;
-uniform mat4 projection;
+// Frame-global state shared by every shader (see ShaderManager::updateFrameUniforms)
+layout (std140) uniform Frame
+{
+    mat4 projection;
+    vec2 viewport;
+    float time;
+    float deltaTime;
+};
 
 void main()
 {
@@ -1,11 +1,21 @@
 #version 330 core
 layout (location = 0) in vec4 vertex; // <vec2 pos, vec2 tex>
+layout (location = 1) in vec3 color;
 out vec2 TexCoords;
+out vec3 TextColor;
 
-uniform mat4 projection;
+// Frame-global state shared by every shader (see ShaderManager::updateFrameUniforms)
+layout (std140) uniform Frame
+{
+    mat4 projection;
+    vec2 viewport;
+    float time;
+    float deltaTime;
+};
 
 void main()
 {
     gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
     TexCoords = vertex.zw;
-}  
\ No newline at end of file
+    TextColor = color;
+}  
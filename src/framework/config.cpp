@@ -0,0 +1,83 @@
+#include "config.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+using std::cout, std::endl;
+
+/// @brief Prints the command line options
+static void printUsage(const char *program) {
+    cout << "Usage: " << program << " [options]\n"
+         << "  --headless            Render offscreen without a window (no display or GPU needed)\n"
+         << "  --frames <n>          Frames to render in headless mode (default 600)\n"
+         << "  --fps <n>             Simulated frames per second in headless mode (default 60)\n"
+         << "  --output <dir>        Write each headless frame to <dir>/frame_NNNNN.png\n"
+         << "  --tick-rate <n>       Simulation ticks per second (default 60)\n"
+         << "  --event-step          Bounce the logo at the exact time of each wall hit\n"
+         << "  --fast-forward <s>    Simulate <s> seconds without rendering, print the counters and exit\n"
+         << "  --logos <n>           Bounce <n> colliding logos instead of one\n"
+         << "  --profile             Show the performance HUD (toggle with F3) and print frame timings at exit\n"
+         << "  --trace <file>        Record a Chrome trace of every frame and write it to <file> at exit (or on F4)\n"
+         << "  --seed <n>            Seed for confetti and click colors (default: random)\n"
+         << "  --record <file>       Record the run's input to <file>\n"
+         << "  --replay <file>       Replay a recorded run without a window and print its corner hits\n"
+         << "  --confetti <n>        Maximum number of confetti alive at once (default 10000)\n"
+         << "  --help                Show this message" << endl;
+}
+
+EngineConfig parseArguments(int argc, char *argv[], ArgumentStatus &status) {
+    EngineConfig config;
+    bool ok = true;
+    bool help = false;
+
+    for (int i = 1; i < argc && ok; i++) {
+        const char *arg = argv[i];
+        // Options that take a value read it from the next argument
+        bool hasValue = i + 1 < argc;
+
+        if (std::strcmp(arg, "--headless") == 0) {
+            config.headless = true;
+        } else if (std::strcmp(arg, "--frames") == 0 && hasValue) {
+            config.frames = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--fps") == 0 && hasValue) {
+            config.frameRate = std::strtof(argv[++i], nullptr);
+            ok = config.frameRate > 0;
+        } else if (std::strcmp(arg, "--output") == 0 && hasValue) {
+            config.outputDir = argv[++i];
+        } else if (std::strcmp(arg, "--tick-rate") == 0 && hasValue) {
+            config.tickRate = std::strtof(argv[++i], nullptr);
+            ok = config.tickRate > 0;
+        } else if (std::strcmp(arg, "--event-step") == 0) {
+            config.eventStepping = true;
+        } else if (std::strcmp(arg, "--fast-forward") == 0 && hasValue) {
+            config.fastForward = std::strtod(argv[++i], nullptr);
+            ok = config.fastForward > 0;
+        } else if (std::strcmp(arg, "--logos") == 0 && hasValue) {
+            config.logoCount = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--profile") == 0) {
+            config.profile = true;
+        } else if (std::strcmp(arg, "--trace") == 0 && hasValue) {
+            config.tracePath = argv[++i];
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            config.seed = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--record") == 0 && hasValue) {
+            config.recordPath = argv[++i];
+        } else if (std::strcmp(arg, "--replay") == 0 && hasValue) {
+            config.replayPath = argv[++i];
+        } else if (std::strcmp(arg, "--confetti") == 0 && hasValue) {
+            config.confettiCapacity = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--help") == 0) {
+            help = true;
+            break;
+        } else {
+            cout << "ERROR::ARGUMENTS: Unknown or incomplete option: " << arg << endl;
+            ok = false;
+        }
+    }
+
+    status = !ok ? ArgumentStatus::Error : help ? ArgumentStatus::Help : ArgumentStatus::Ok;
+    if (status != ArgumentStatus::Ok)
+        printUsage(argv[0]);
+    return config;
+}
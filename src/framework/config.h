@@ -0,0 +1,74 @@
+#ifndef GRAPHICS_CONFIG_H
+#define GRAPHICS_CONFIG_H
+
+#include <string>
+
+/// @brief Startup options for the Engine, usually filled in from the command line by parseArguments().
+struct EngineConfig {
+    /// @brief The maximum number of confetti alive at once (preallocated at startup)
+    size_t confettiCapacity = 10000;
+
+    /// @brief Simulation ticks per second
+    /// @details The simulation always advances in ticks of 1 / tickRate seconds, independent of the display's refresh rate.
+    float tickRate = 60.0f;
+
+    /// @brief Step the logo by exact time of impact instead of moving and clamping (see StepMode::Event)
+    bool eventStepping = false;
+
+    /// @brief If positive, fast-forward the simulation by this many seconds, print the result and exit without opening a window
+    double fastForward = 0;
+
+    /// @brief Number of colliding logos to bounce instead of the single logo (0 for the single logo)
+    size_t logoCount = 0;
+
+    /// @brief Show the performance HUD from the start and print the profiler's statistics at exit
+    bool profile = false;
+
+    /// @brief File to write a Chrome trace of the engine's frames to (at exit and when F4 is pressed; empty to not trace)
+    std::string tracePath;
+
+    /// @brief Seed for the engine's random generator (confetti and click colors); 0 picks one at startup
+    unsigned int seed = 0;
+
+    /// @brief File to record the run's input to, for replaying it later (empty to not record)
+    std::string recordPath;
+
+    /// @brief Input log to replay instead of reading the keyboard and mouse (empty for a normal run)
+    /// @details The replay takes its settings from the log, runs without a window or rendering as fast as possible,
+    /// prints every corner hit and checks the final counters against the recording.
+    std::string replayPath;
+
+    /// @brief Run without a visible window, rendering into an offscreen framebuffer
+    /// @details Uses GLFW's null platform with an OSMesa (software) context where available,
+    /// so no display server or GPU is needed.
+    bool headless = false;
+
+    /// @brief Number of frames to render before exiting in headless mode
+    unsigned int frames = 600;
+
+    /// @brief Simulated frames per second in headless mode (each frame advances time by 1 / frameRate)
+    float frameRate = 60.0f;
+
+    /// @brief Directory to write each headless frame to as a PNG (empty to not write frames)
+    std::string outputDir;
+};
+
+/// @brief The outcome of parseArguments()
+enum class ArgumentStatus {
+    /// @brief The arguments were parsed, run with the config
+    Ok,
+    /// @brief --help was given, usage has been printed
+    Help,
+    /// @brief An argument was not recognized or had a bad value, usage has been printed
+    Error
+};
+
+/// @brief Builds an EngineConfig from the command line.
+/// @details Prints usage if --help is given or an argument is not recognized or is missing its value.
+/// @param argc The argument count passed to main()
+/// @param argv The arguments passed to main()
+/// @param status Set to whether to run, exit successfully (help) or exit with an error
+/// @return The parsed config (defaults for anything not given)
+EngineConfig parseArguments(int argc, char *argv[], ArgumentStatus &status);
+
+#endif //GRAPHICS_CONFIG_H
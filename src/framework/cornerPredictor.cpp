@@ -0,0 +1,113 @@
+#include "cornerPredictor.h"
+
+#include <cmath>
+
+// The recursion in firstInRange() halves its modulus at least every other level, so running past this
+// means the tolerance is below what double precision can resolve
+const int MAX_DEPTH = 200;
+
+/// @brief Returns the smallest n >= 0 with (a * n) mod m in [l, r], or -1 if there is none
+/// @details Real-valued version of the Euclid-style recursion for modular ranges. Requires 0 <= l <= r < m.
+static double firstInRange(double a, double m, double l, double r, int depth) {
+    if (l <= 0)
+        return 0;
+    a = std::fmod(a, m);
+    if (a <= 0 || depth > MAX_DEPTH)
+        return -1;
+
+    // Mirror so a <= m / 2, which keeps the recursion logarithmic
+    if (2 * a > m)
+        return firstInRange(m - a, m, m - r, m - l, depth + 1);
+
+    // Reached before the first wrap-around
+    double k = std::ceil(l / a);
+    if (k * a <= r)
+        return k;
+
+    // Otherwise a * n must wrap y >= 1 times: find the smallest y for which [l + m y, r + m y] holds a
+    // multiple of a, which is the same problem one level down with modulus a
+    double base = a * std::floor(l / a);
+    double wraps = firstInRange(a - std::fmod(m, a), a, l - base, r - base, depth + 1);
+    if (wraps < 0)
+        return -1;
+    return std::ceil((l + m * wraps) / a);
+}
+
+CornerPredictor::CornerPredictor(const Logo &logo, vec2 bounds)
+    : x(makeAxis(logo.pos.x, logo.velocity.x, logo.size.x, bounds.x)),
+      y(makeAxis(logo.pos.y, logo.velocity.y, logo.size.y, bounds.y)) {}
+
+CornerPredictor::Axis CornerPredictor::makeAxis(double pos, double velocity, double size, double bound) {
+    // The logo's center moves between low and high
+    double low = size / 2, high = bound - size / 2;
+    double length = high - low;
+    if (velocity == 0 || length <= 0)
+        return {0, 0, false, false};
+
+    double speed = std::fabs(velocity);
+    double first = velocity > 0 ? (high - pos) / speed : (pos - low) / speed;
+    return {first > 0 ? first : 0, length / speed, velocity > 0, true};
+}
+
+bool CornerPredictor::isHighHit(const Axis &axis, double index) {
+    bool odd = std::fmod(index, 2) != 0;
+    return axis.firstHigh != odd;
+}
+
+vector<WallHit> CornerPredictor::nextWallHits(size_t count) const {
+    vector<WallHit> hits;
+    hits.reserve(count);
+
+    // Merge the two sequences
+    double i = 0, j = 0;
+    while (hits.size() < count && (x.moving || y.moving)) {
+        double timeX = x.moving ? x.first + i * x.period : INFINITY;
+        double timeY = y.moving ? y.first + j * y.period : INFINITY;
+        if (timeX <= timeY) {
+            hits.push_back({timeX, isHighHit(x, i) ? Wall::Right : Wall::Left});
+            i++;
+        } else {
+            hits.push_back({timeY, isHighHit(y, j) ? Wall::Top : Wall::Bottom});
+            j++;
+        }
+    }
+    return hits;
+}
+
+bool CornerPredictor::nextCornerHit(CornerHit &hit, double tolerance) const {
+    if (!x.moving || !y.moving)
+        return false;
+
+    // Skip the x hits that come before the first y hit
+    double start = 0;
+    if (x.first < y.first - tolerance)
+        start = std::ceil((y.first - tolerance - x.first) / x.period);
+
+    // Want the smallest n with (x.first + (start + n) * x.period - y.first) within tolerance of a multiple
+    // of y.period; shifting by the tolerance turns that into (offset + n * x.period) mod y.period in [0, 2 tolerance]
+    double width = 2 * tolerance;
+    double offset = std::fmod(x.first + start * x.period - y.first + tolerance, y.period);
+    if (offset < 0)
+        offset += y.period;
+
+    double n;
+    if (offset <= width || width >= y.period)
+        n = 0;
+    else
+        n = firstInRange(x.period, y.period, y.period - offset, y.period - offset + width, 0);
+    if (n < 0)
+        return false;
+
+    double i = start + n;
+    double time = x.first + i * x.period;
+    double j = std::round((time - y.first) / y.period);
+    if (j < 0)
+        j = 0;
+    if (!std::isfinite(time) || std::fabs(y.first + j * y.period - time) > tolerance * (1 + 1e-9))
+        return false; // Rounding error swamped the tolerance
+
+    bool right = isHighHit(x, i), top = isHighHit(y, j);
+    hit.time = time;
+    hit.corner = top ? (right ? Corner::TopRight : Corner::TopLeft) : (right ? Corner::BottomRight : Corner::BottomLeft);
+    return true;
+}
@@ -0,0 +1,60 @@
+#ifndef GRAPHICS_CORNERPREDICTOR_H
+#define GRAPHICS_CORNERPREDICTOR_H
+
+#include <vector>
+#include "simulation.h"
+
+using std::vector;
+
+/**
+ * @brief Predicts wall and corner hits of a bouncing logo in closed form
+ * @details Each axis bounces independently, so the logo's x and y wall hits form two arithmetic
+ * sequences: the first hit after T seconds and then one every P = L / |v| seconds, where L is the
+ * distance the logo's center can travel between the two walls. A corner is a time where the two
+ * sequences meet, which is found with a Euclid-style recursion over the hit periods in O(log) steps
+ * rather than by stepping frames. Predictions follow the exact (continuous) path of the logo.
+ */
+class CornerPredictor {
+    public:
+        /// @brief The default largest gap, in seconds, between an x and a y wall hit that still counts as a corner
+        static constexpr double DEFAULT_TOLERANCE = Simulation::CORNER_TOLERANCE;
+
+        /// @brief Construct a new Corner Predictor object
+        /// @param logo Position, velocity and size of the logo
+        /// @param bounds Width and height of the box (the window size)
+        CornerPredictor(const Logo &logo, vec2 bounds);
+
+        /// @brief Returns the next count wall hits in time order
+        /// @details A corner shows up as two wall hits with the same time. Fewer than count hits are
+        /// returned if the logo isn't moving.
+        vector<WallHit> nextWallHits(size_t count) const;
+
+        /// @brief Finds the next time the logo hits a corner
+        /// @param hit Set to the time and corner of the hit
+        /// @param tolerance Largest gap in seconds between the x and y wall hits that still counts as a corner
+        /// @return false if the logo never hits a corner (or not within the reach of double precision)
+        bool nextCornerHit(CornerHit &hit, double tolerance = DEFAULT_TOLERANCE) const;
+
+    private:
+        /// @brief The hit sequence of one axis
+        struct Axis {
+            /// @brief Seconds until the first hit
+            double first;
+            /// @brief Seconds between hits
+            double period;
+            /// @brief Whether the first hit is on the high (right/top) wall; later hits alternate
+            bool firstHigh;
+            /// @brief false if the logo never hits a wall on this axis
+            bool moving;
+        };
+
+        Axis x, y;
+
+        /// @brief Builds the hit sequence of one axis from its position, velocity, logo size and box size
+        static Axis makeAxis(double pos, double velocity, double size, double bound);
+
+        /// @brief Returns the wall of the index-th hit on an axis
+        static bool isHighHit(const Axis &axis, double index);
+};
+
+#endif //GRAPHICS_CORNERPREDICTOR_H
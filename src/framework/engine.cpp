@@ -1,4 +1,6 @@
 #include "engine.h"
+#include <cstdio>
+#include <ctime>
 #include <string>
 
 // Create game states
@@ -12,17 +14,87 @@ const color BLUE(0, 0, 1);
 const color YELLOW(1, 1, 0);
 const color RED(1, 0, 0);
 
-Engine::Engine() : keys(){
-    this->initWindow();
+// Change in the logo's velocity per second while an arrow key is held (1 per frame at 60 fps)
+const float STEER_ACCELERATION = 60.0f;
+
+// Downward acceleration of the confetti per second (2 per frame at 60 fps)
+const float CONFETTI_GRAVITY = 120.0f;
+
+// Longest frame the simulation will catch up on, so a stall doesn't trigger a burst of ticks
+const double MAX_FRAME_TIME = 0.25;
+
+Engine::Engine(const EngineConfig &config) : config(config), simulation(createSimulation(config)), tickTime(1.0f / config.tickRate), confetti(config.confettiCapacity), hudVisible(config.profile) {
+    jobSystem = make_unique<JobSystem>();
+    if (!config.tracePath.empty())
+        trace = make_unique<TraceRecorder>();
+    if (config.logoCount > 0) {
+        logoField = make_unique<LogoField>(vec2(WIDTH, HEIGHT), config.eventStepping ? StepMode::Event : StepMode::Clamp);
+        logoField->scatter(config.logoCount, 1);
+    }
+
+    // Keep the seed that was actually used so a recording can reproduce it
+    if (this->config.seed == 0)
+        this->config.seed = std::random_device()();
+    rng.seed(this->config.seed);
+    previousPos = simulation.getLogo().pos;
+
+    if (!config.replayPath.empty()) {
+        // Only the simulation runs: no window, shaders or shapes
+        replay = make_unique<InputReplay>(config.replayPath);
+        replayFinished = !replay->isOpen();
+        return;
+    }
+    if (!config.recordPath.empty()) {
+        recorder = make_unique<InputRecorder>(config.recordPath, this->config);
+        if (!recorder->isOpen())
+            recorder.reset();
+    }
+
+    if (this->initWindow() != 0)
+        return; // shouldClose() reports true without a window
     this->initShaders();
     this->initShapes();
 }
 
-Engine::~Engine() {}
+Engine::~Engine() {
+    if (config.profile && window != nullptr)
+        profiler.report(cout);
+    if (trace)
+        writeTrace();
+    if (recorder)
+        recorder->finish(getWallsHit(), getCornersHit());
+    if (replay && replay->isOpen())
+        reportReplay();
+
+    // Shapes only borrow their buffers, so the shared geometry is deleted once here
+    GeometryCache::clear();
+}
+
+Simulation Engine::createSimulation(const EngineConfig &config) {
+    // Start with a 50x30 logo in the middle of the screen
+    return Simulation(vec2(WIDTH, HEIGHT), {dvec2(WIDTH / 2, HEIGHT / 2), dvec2(100, 100), vec2(50, 30)},
+                      config.eventStepping ? StepMode::Event : StepMode::Clamp);
+}
+
+long long Engine::fastForward(double seconds) {
+    long long corners = simulation.fastForward(seconds);
+
+    // Skip the interpolation too, so the logo doesn't slide across the screen from where it was
+    previousPos = simulation.getLogo().pos;
+    return corners;
+}
 
 unsigned int Engine::initWindow(bool debug) {
     // glfw: initialize and configure
-    glfwInit();
+#ifdef GLFW_PLATFORM_NULL
+    // GLFW 3.4+: the null platform needs no display server at all
+    if (config.headless)
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#endif
+    if (!glfwInit()) {
+        cout << "Failed to initialize GLFW" << endl;
+        return -1;
+    }
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
@@ -33,12 +105,27 @@ unsigned int Engine::initWindow(bool debug) {
 #endif
     glfwWindowHint(GLFW_RESIZABLE, false);
 
+    if (config.headless) {
+        // The window only hosts the context; everything is drawn into an offscreen framebuffer.
+        // OSMesa renders in software, so no GPU is needed either.
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef GLFW_OSMESA_CONTEXT_API
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+#endif
+    }
+
     window = glfwCreateWindow(WIDTH, HEIGHT, "engine", nullptr, nullptr);
+    if (window == nullptr) {
+        cout << "Failed to create GLFW window" << endl;
+        return -1;
+    }
     glfwMakeContextCurrent(window);
+    input.attach(window);
 
     // glad: load all OpenGL function pointers
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
         cout << "Failed to initialize GLAD" << endl;
+        destroyWindow();
         return -1;
     }
 
@@ -46,11 +133,33 @@ unsigned int Engine::initWindow(bool debug) {
     glViewport(0, 0, WIDTH, HEIGHT);
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glfwSwapInterval(1);
+
+    if (config.headless) {
+        // No display to sync to: render frames as fast as possible
+        glfwSwapInterval(0);
+        framebuffer = make_unique<Framebuffer>(WIDTH, HEIGHT);
+        if (!framebuffer->isComplete()) {
+            framebuffer.reset();
+            destroyWindow();
+            return -1;
+        }
+    } else {
+        glfwSwapInterval(1);
+    }
+
+    // Time every phase on the GPU as well (GL_TIME_ELAPSED is core in 3.3)
+    profiler.initGpuTimers();
 
     return 0;
 }
 
+void Engine::destroyWindow() {
+    // Without a window shouldClose() reports true and render() draws nothing, so the main loop never touches
+    // the renderers that were not created
+    glfwDestroyWindow(window);
+    window = nullptr;
+}
+
 void Engine::initShaders() {
     // Load shader manager
     shaderManager = make_unique<ShaderManager>();
@@ -64,249 +173,402 @@ void Engine::initShaders() {
     textShader = shaderManager->loadShader("../res/shaders/text.vert", "../res/shaders/text.frag", nullptr, "text");
     fontRenderer = make_unique<FontRenderer>(shaderManager->getShader("text"), "../res/fonts/MxPlus_IBM_BIOS.ttf", 24);
 
+    // Lay out the labels once; they are only laid out again when their text changes
+    vec3 labelColor = {1, 1, 1};
+    pauseLabel = make_unique<TextLayout>(*fontRenderer, "Press P to pause", (WIDTH / 2) - 100, (HEIGHT / 2), 0.5, labelColor);
+    returnLabel = make_unique<TextLayout>(*fontRenderer, "Press backspace to return", (WIDTH / 2) - 100, (HEIGHT / 2) + 50, 0.5, labelColor);
+    wallsLabel = make_unique<TextLayout>(*fontRenderer, "Walls Hit: 0", (WIDTH / 2) - 100, (HEIGHT / 2) + 20, 0.5, labelColor);
+    cornersLabel = make_unique<TextLayout>(*fontRenderer, "Corners Hit: 0", (WIDTH / 2) - 100, (HEIGHT / 2), 0.5, labelColor);
+
+    // Configure instanced confetti shader and renderer
+    particleShader = shaderManager->loadShader("../res/shaders/particle.vert", "../res/shaders/particle.frag", nullptr, "particle");
+    particleRenderer = make_unique<ParticleRenderer>(shaderManager->getShader("particle"));
+    particleRenderer->reserve(confetti.getCapacity());
+    if (logoField) {
+        logoRenderer = make_unique<ParticleRenderer>(shaderManager->getShader("particle"));
+        logoRenderer->reserve(logoField->size());
+    }
+
     textShader.use().setVector2f("vertex", vec4(100, 100, .5, .5));
-    shapeShader.use();
-    shapeShader.setMatrix4("projection", this->PROJECTION);
 }
 
 void Engine::initShapes() {
-    // Make a 50x30 white rectangle for initialization
-    dvd = make_unique<Rect>(shapeShader, vec2(WIDTH / 2, HEIGHT / 2), vec2(50, 30), vec2(100, 100), WHITE);
+    // Make a white rectangle matching the simulated logo
+    const Logo &logo = simulation.getLogo();
+    dvd = make_unique<Rect>(shapeShader, vec2(logo.pos), logo.size, vec2(logo.velocity), WHITE);
+    previousPos = logo.pos;
 }
 
 void Engine::processInput() {
-    glfwPollEvents();
-
-    // Set keys to true if pressed, false if released
-    for (int key = 0; key < 1024; ++key) {
-        if (glfwGetKey(window, key) == GLFW_PRESS)
-            keys[key] = true;
-        else if (glfwGetKey(window, key) == GLFW_RELEASE)
-            keys[key] = false;
+    profiler.beginFrame();
+    ProfileScope scope(profiler, Profiler::Input);
+    frameStart = TraceRecorder::Clock::now();
+    TraceScope span(trace.get(), "Input");
+
+    // The callbacks record every key and mouse button transition while the events are polled
+    // (or the replay feeds in the ones that were recorded for this frame)
+    input.beginFrame();
+    if (replay) {
+        if (!replay->nextFrame(input))
+            replayFinished = true;
+    } else {
+        TraceScope poll(trace.get(), "Poll events");
+        glfwPollEvents();
     }
 
     // Pause if the "P" key is pressed
-    if (screen == play && glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS) {
+    if (screen == play && input.wasKeyPressed(GLFW_KEY_P)) {
         screen = pause;
     }
 
     // If paused, return to game if "Backspace" is pressed
-    if (screen == pause && glfwGetKey(window, GLFW_KEY_BACKSPACE) == GLFW_PRESS) {
+    if (screen == pause && input.wasKeyPressed(GLFW_KEY_BACKSPACE)) {
         screen = play;
     }
 
+    // Show or hide the performance HUD
+    if (input.wasKeyPressed(GLFW_KEY_F3))
+        hudVisible = !hudVisible;
+
+    // Write the trace recorded so far
+    if (trace && input.wasKeyPressed(GLFW_KEY_F4))
+        writeTrace();
+
     // Close window if escape key is pressed
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
+    if (window != nullptr && input.isKeyDown(GLFW_KEY_ESCAPE)) {
         glfwSetWindowShouldClose(window, true);
     }
 
     // Mouse position saved to check for collisions
-    glfwGetCursorPos(window, &mouseX, &mouseY);
-    mouseY = HEIGHT - mouseY; // make sure mouse y-axis isn't flipped
+    if (window != nullptr) {
+        glfwGetCursorPos(window, &mouseX, &mouseY);
+        mouseY = HEIGHT - mouseY; // make sure mouse y-axis isn't flipped
+    }
 
-    // Allow the user to change the velocity of dvd logo with the arrow keys
-    if (screen == play && glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS) {
-        vec2 velocity = dvd->getVelocity();
-        velocity.y = velocity.y + 1;
-        dvd->setVelocity(velocity);
+    // Allow the user to change the velocity of dvd logo with the arrow keys (applied every tick)
+    steering = vec2(0, 0);
+    if (screen == play && input.isKeyDown(GLFW_KEY_UP)) {
+        steering.y = steering.y + 1;
     }
-    if (screen == play && glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS) {
-        vec2 velocity = dvd->getVelocity();
-        velocity.y = velocity.y - 1;
-        dvd->setVelocity(velocity);
+    if (screen == play && input.isKeyDown(GLFW_KEY_DOWN)) {
+        steering.y = steering.y - 1;
     }
-    if (screen == play && glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS) {
-        vec2 velocity = dvd->getVelocity();
-        velocity.x = velocity.x - 1;
-        dvd->setVelocity(velocity);
+    if (screen == play && input.isKeyDown(GLFW_KEY_LEFT)) {
+        steering.x = steering.x - 1;
     }
-    if (screen == play && glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS) {
-        vec2 velocity = dvd->getVelocity();
-        velocity.x = velocity.x + 1;
-        dvd->setVelocity(velocity);
+    if (screen == play && input.isKeyDown(GLFW_KEY_RIGHT)) {
+        steering.x = steering.x + 1;
     }
 
-    // Change the color of the rectangle each time the user clicks the mouse
-    bool mousePressed = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
-
-    if (screen == play && mousePressed) {
-        color color = {float(rand() % 10 / 10.0), float(rand() % 10 / 10.0), float(rand() % 10 / 10.0), 1.0f};
-        dvd->setColor(color);
+    // Change the color of the rectangle once for each click
+    // (the color is drawn even without a logo to show, so a replay uses the generator exactly like the recording did)
+    if (screen == play && input.wasButtonPressed(GLFW_MOUSE_BUTTON_LEFT)) {
+        color color = randomColor();
+        if (dvd)
+            dvd->setColor(color);
     }
 }
 
 
-void Engine::checkBounds(unique_ptr<Rect> &dvd) {
-    // Get position, velocity, and size of the moving rectangle
-    vec2 position = dvd->getPos();
-    vec2 velocity = dvd->getVelocity();
-    vec2 size = dvd->getSize();
-
-    // Get new position
-    position += velocity * deltaTime;
-
-    // If the rectangle hits the edges of the screen, bounce it in the other direction
-    if (position.x - (size.x / 2) <= 0 && screen == play) {  // Hits left wall
-        position.x = (size.x / 2);
-        velocity.x = -velocity.x;
-        wallsHit++;
-    }
-    if (position.x + (size.x / 2) >= WIDTH && screen == play) {  // Hits right wall
-        position.x = WIDTH - (size.x / 2);
-        velocity.x = -velocity.x;
-        wallsHit++;
-    }
-    if (position.y - (size.y / 2) <= 0 && screen == play) {  // Hits bottom wall
-        position.y = (size.y / 2);
-        velocity.y = -velocity.y;
-        wallsHit++;
-    }
-    if (position.y + (size.y / 2) >= HEIGHT && screen == play) {  // Hits top wall
-        position.y = HEIGHT - (size.y / 2);
-        velocity.y = -velocity.y;
-        wallsHit++;
+void Engine::tick(float deltaTime) {
+    // Apply the arrow keys held this frame
+    if (steering != vec2(0, 0)) {
+        simulation.setVelocity(simulation.getLogo().velocity + dvec2(steering) * double(STEER_ACCELERATION * deltaTime));
     }
 
-    // Determine if a corner has been hit and spawn confetti if it has
-    if (position.x - (size.x / 2) <= 0 && position.y - (size.y / 2) <= 0 && screen == play) {
-        cornersHit++;
-        spawnConfetti();
-    }
-    if (position.x + (size.x / 2) >= WIDTH && position.y - (size.y / 2) <= 0 && screen == play) {
-        cornersHit++;
-        spawnConfetti();
-    }
-    if (position.x - (size.x / 2) <= 0 && position.y + (size.y / 2) >= HEIGHT && screen == play) {
-        cornersHit++;
-        spawnConfetti();
+    // Move the logo (or every logo) and spawn confetti for every corner hit
+    unsigned int corners;
+    {
+        TraceScope span(trace.get(), "Simulation step");
+        corners = logoField ? logoField->step(deltaTime) : simulation.step(deltaTime);
     }
-    if (position.x + (size.x / 2) >= WIDTH && position.y + (size.y / 2) >= HEIGHT && screen == play) {
-        cornersHit++;
-        spawnConfetti();
+    if (corners > 0) {
+        TraceScope span(trace.get(), "Spawn confetti");
+        for (unsigned int i = 0; i < corners; i++) {
+            spawnConfetti();
+        }
     }
 
-    // Set the new position and velocity of the moving rectangle
-    dvd->setPos(position);
-    dvd->setVelocity(velocity);
+    // Move the confetti
+    checkConfettiBounds(deltaTime);
 }
 
-void Engine::checkConfettiBounds(unique_ptr<Rect> &confetti) {
-    // Get position, velocity, and size of each confetti
-    vec2 velocity = confetti->getVelocity();
-    vec2 position = confetti->getPos();
-    vec2 size = confetti->getSize();
-
-    // Update the position of each confetti
-    position += velocity * deltaTime;
-
-    // Make the confetti velocity decrease by 2 to simulate gravity
-    velocity.y = velocity.y - 2;
-
-    // Determine if there is still confetti on the screen
-    if (position.y + (size.y / 2) >= 0 && screen == play) {
-        confettiOnScreen = true;
-    }
-
-    // Set confetti velocity and position
-    confetti->setVelocity(velocity);
-    confetti->setPos(position);
+void Engine::checkConfettiBounds(float deltaTime) {
+    // Move every confetti and make its velocity decrease to simulate gravity
+    TraceScope span(trace.get(), "Confetti update");
+    confetti.update(deltaTime, CONFETTI_GRAVITY * deltaTime, jobSystem.get());
 }
 
 void Engine::update() {
-    // Set confetti on screen to false
-    confettiOnScreen = false;
-
-    // Calculate delta time
-    float currentFrame = glfwGetTime();
-    deltaTime = currentFrame - lastFrame;
-    lastFrame = currentFrame;
+    ProfileScope scope(profiler, Profiler::Update);
+    TraceScope span(trace.get(), "Update");
+
+    // Calculate delta time (a replay uses the recorded one, so the ticks line up exactly)
+    if (replay) {
+        if (replayFinished)
+            return;
+        deltaTime = replay->getDeltaTime();
+        lastFrame += deltaTime;
+    } else {
+        double currentFrame = getTime();
+        deltaTime = currentFrame - lastFrame;
+        lastFrame = currentFrame;
+    }
+    if (recorder)
+        recorder->writeFrame(deltaTime, input.getEvents());
 
-    // Prevent dvd from moving offscreen
+    // Run as many fixed ticks as the elapsed time covers; the remainder carries over to the next frame
     if (screen == play) {
-        checkBounds(dvd);
-
-        // Check the bounds of the confetti
-        for (int i = 0; i < confetti.size(); i++) {
-            checkConfettiBounds(confetti[i]);
+        accumulator += deltaTime < MAX_FRAME_TIME ? deltaTime : MAX_FRAME_TIME;
+        while (accumulator >= tickTime) {
+            previousPos = simulation.getLogo().pos;
+            tick(tickTime);
+            accumulator -= tickTime;
         }
+    } else {
+        accumulator = 0.0;
     }
+    if (replay)
+        reportCorners();
+
+    // Determine if there is still confetti on the screen
+    confettiOnScreen = screen == play && !confetti.empty();
 
-    // Clear the confetti vector if there are no more confetti on the screen
+    // Clear the confetti if there are no more confetti on the screen
     if (!(confettiOnScreen)) {
         confetti.clear();
     }
 }
 
 void Engine::render() {
-    glClearColor(BLACK.red, BLACK.green, BLACK.blue, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
+    // Nothing to draw to in a replay
+    if (window == nullptr)
+        return;
+
+    profiler.begin(Profiler::Render);
+    TraceRecorder::Clock::time_point renderStart = TraceRecorder::Clock::now();
+
+    {
+        TraceScope pass(trace.get(), "Clear");
 
-    shapeShader.use();
+        // In headless mode draw into the offscreen framebuffer
+        if (framebuffer)
+            framebuffer->bind();
+
+        glClearColor(BLACK.red, BLACK.green, BLACK.blue, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        // Upload projection, viewport and timing once for every shader
+        shaderManager->updateFrameUniforms({PROJECTION, vec2(WIDTH, HEIGHT), float(lastFrame), deltaTime});
+
+        shapeShader.use();
+    }
 
     // Render differently depending on screen
     switch (screen) {
         case pause: {
-            string message1 = "Press backspace to return";
-            string message2 = "Walls Hit: " + std::to_string(wallsHit);
-            string message3 = "Corners Hit: " + std::to_string(cornersHit);
+            TraceScope pass(trace.get(), "Pause screen");
+
+            // Only lay the counters out again when they have changed since they were last shown
+            if (wallsShown != getWallsHit()) {
+                wallsShown = getWallsHit();
+                wallsLabel->setText("Walls Hit: " + std::to_string(wallsShown));
+            }
+            if (cornersShown != getCornersHit()) {
+                cornersShown = getCornersHit();
+                cornersLabel->setText("Corners Hit: " + std::to_string(cornersShown));
+            }
 
             // Display the message on the screen
-            fontRenderer->renderText(message1, (WIDTH / 2) - 100, (HEIGHT / 2) + 50, 0.5, vec3{1, 1, 1});
-            fontRenderer->renderText(message2, (WIDTH / 2) - 100, (HEIGHT / 2) + 20, 0.5, vec3{1, 1, 1});
-            fontRenderer->renderText(message3, (WIDTH / 2) - 100, (HEIGHT / 2), 0.5, vec3{1, 1, 1});
+            returnLabel->draw();
+            wallsLabel->draw();
+            cornersLabel->draw();
             break;
         }
         case play: {
-            string message = "Press P to pause";
-
-            // Display confetti
-            for (int i = 0; i < confetti.size(); i++) {
-                confetti[i]->setUniforms();
-                confetti[i]->draw();
+            // Display all confetti with one instanced draw call
+            {
+                TraceScope pass(trace.get(), "Confetti pass");
+                particleRenderer->render(confetti);
+            }
+            profiler.setParticleCount(confetti.size() + (logoField ? logoField->size() : 0));
+
+            if (logoField) {
+                // Display every logo with one instanced draw call
+                TraceScope pass(trace.get(), "Logo pass");
+                logoRenderer->render(logoField->getX(), logoField->getY(), logoField->getWidth(),
+                                     logoField->getHeight(), logoField->getColors(), logoField->size());
+            } else {
+                // Display rectangle, interpolated between the last two ticks
+                TraceScope pass(trace.get(), "Logo pass");
+                float alpha = float(accumulator / tickTime);
+                dvd->setPos(vec2(glm::mix(previousPos, simulation.getLogo().pos, double(alpha))));
+                shapeShader.use();
+                dvd->setUniforms();
+                dvd->draw();
             }
-
-            // Display rectangle
-            dvd->setUniforms();
-            dvd->draw();
 
             // Display the message on the screen
-            fontRenderer->renderText(message, (WIDTH / 2) - 100, (HEIGHT / 2), 0.5, vec3{1, 1, 1});
+            pauseLabel->draw();
             break;
         }
     }
-    glfwSwapBuffers(window);
+
+    {
+        TraceScope pass(trace.get(), "Text pass");
+        if (hudVisible)
+            drawHud();
+
+        // Draw every string queued above in one call
+        fontRenderer->flush();
+    }
+    profiler.end(Profiler::Render);
+    if (trace)
+        trace->record("Render", renderStart, TraceRecorder::Clock::now());
+
+    profiler.begin(Profiler::Present);
+    if (config.headless) {
+        // Nothing to present; optionally save the frame instead
+        if (!config.outputDir.empty()) {
+            TraceScope span(trace.get(), "Save frame");
+            char name[32];
+            std::snprintf(name, sizeof(name), "/frame_%05u.png", framesRendered);
+            framebuffer->savePNG(config.outputDir + name);
+        }
+    } else {
+        // Blocks until vsync, so long swaps here are frames that missed it
+        TraceScope span(trace.get(), "Swap buffers");
+        glfwSwapBuffers(window);
+    }
+    profiler.end(Profiler::Present);
+    framesRendered++;
+
+    if (trace)
+        trace->record("Frame", frameStart, TraceRecorder::Clock::now());
+}
+
+void Engine::writeTrace() {
+    if (trace->write(config.tracePath))
+        cout << "Trace written to " << config.tracePath << " (" << trace->getRecorded() << " spans recorded)" << endl;
+}
+
+void Engine::drawHud() {
+    // Statistics cover the last Profiler::HISTORY frames; the counters are the previous frame's
+    const float scale = 0.4f;
+    const float lineHeight = 14.0f;
+    const vec3 hudColor = {1, 1, 0};
+    float y = HEIGHT - lineHeight;
+    char line[96];
+
+    Profiler::Stats frame = profiler.getFrameStats();
+    std::snprintf(line, sizeof(line), "Frame %6.2f ms  min %6.2f  avg %6.2f  p99 %6.2f",
+                  frame.last, frame.min, frame.avg, frame.p99);
+    fontRenderer->renderText(line, 8, y, scale, hudColor);
+
+    for (int phase = 0; phase < Profiler::PHASE_COUNT; phase++) {
+        Profiler::Stats cpu = profiler.getCpuStats(Profiler::Phase(phase));
+        Profiler::Stats gpu = profiler.getGpuStats(Profiler::Phase(phase));
+        y -= lineHeight;
+        std::snprintf(line, sizeof(line), "%-8s cpu %5.2f p99 %5.2f  gpu %5.2f p99 %5.2f",
+                      Profiler::getName(Profiler::Phase(phase)), cpu.avg, cpu.p99, gpu.avg, gpu.p99);
+        fontRenderer->renderText(line, 8, y, scale, hudColor);
+    }
+
+    y -= lineHeight;
+    std::snprintf(line, sizeof(line), "Draws %u  Uniforms %u  Particles %zu",
+                  profiler.getDrawCalls(), profiler.getUniformUploads(), profiler.getParticleCount());
+    fontRenderer->renderText(line, 8, y, scale, hudColor);
 }
 
 void Engine::spawnConfetti() {
     int numConfetti = 100;
 
-    // Create 100 confetti
-    for (int i = 0; i < numConfetti; i++) {
+    // Create 100 confetti (or as many as there are free slots)
+    for (int i = 0; i < numConfetti && !confetti.full(); i++) {
         // Initialize position of confetti
         vec2 pos = {0, 0};
         // Initialize the velocity of the confetti
         vec2 velocity = {0, 0};
 
         // We want some confetti to spawn on the right and some to spawn on the left
-        int pickPos = rand() % 2;
+        int pickPos = random(2);
         if (pickPos == 0) {
             pos = {0, HEIGHT / 2};
-            velocity = {rand() % 100 + 75, rand() % 75 + 30};
+            velocity = {random(100) + 75, random(75) + 30};
         } else {
             pos = {WIDTH, HEIGHT / 2};
-            velocity = {-(rand() % 100 + 75), rand() % 75 + 30};
+            velocity = {-(random(100) + 75), random(75) + 30};
         }
 
         // Set the size of the confetti
         vec2 size = {10, 10};
 
         // Set the color of the confetti
-        color color = {float(rand() % 10 / 10.0), float(rand() % 10 / 10.0), float(rand() % 10 / 10.0), 1.0f};
+        color color = randomColor();
 
-        confetti.push_back(make_unique<Rect>(shapeShader, pos, size, velocity, color));
+        confetti.spawn(pos, velocity, size, color.vec);
+    }
+}
+
+int Engine::random(int n) {
+    return int(rng() % unsigned(n));
+}
+
+color Engine::randomColor() {
+    // Braced initializers are evaluated left to right, so the channels always draw in the same order
+    return {float(random(10) / 10.0), float(random(10) / 10.0), float(random(10) / 10.0), 1.0f};
+}
+
+void Engine::reportCorners() {
+    long long corners = getCornersHit();
+    if (corners == cornersReported)
+        return;
+    cornersReported = corners;
+
+    // lastFrame is the time since the recording started, as the recording's frames measured it
+    std::time_t when = std::time_t(replay->getStartTime() + int64_t(lastFrame));
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", std::localtime(&when));
+    cout << "Corner " << corners << " at " << stamp << " (frame " << replay->getFrames() << ", "
+         << lastFrame << " s): Walls Hit " << getWallsHit() << endl;
+}
+
+void Engine::reportReplay() {
+    cout << "Replayed " << replay->getFrames() << " frames\n"
+         << "Walls Hit: " << getWallsHit() << "\n"
+         << "Corners Hit: " << getCornersHit() << endl;
+
+    if (!replay->hasEnd()) {
+        cout << "The recording was cut short, so there are no final counters to compare with" << endl;
+    } else if (replay->getRecordedWallsHit() == getWallsHit() && replay->getRecordedCornersHit() == getCornersHit() &&
+               replay->getRecordedFrames() == replay->getFrames()) {
+        cout << "Replay matches the recording" << endl;
+    } else {
+        cout << "ERROR::REPLAY: The recording ended with " << replay->getRecordedWallsHit() << " walls and "
+             << replay->getRecordedCornersHit() << " corners after " << replay->getRecordedFrames() << " frames" << endl;
     }
 }
 
 bool Engine::shouldClose() {
+    if (replay)
+        return replayFinished;
+    if (window == nullptr)
+        return true;
+    if (config.headless)
+        return framesRendered >= config.frames;
     return glfwWindowShouldClose(window);
+}
+
+long long Engine::getWallsHit() const {
+    return logoField ? logoField->getWallsHit() : simulation.getWallsHit();
+}
+
+long long Engine::getCornersHit() const {
+    return logoField ? logoField->getCornersHit() : simulation.getCornersHit();
+}
+
+double Engine::getTime() const {
+    if (config.headless)
+        return framesRendered / double(config.frameRate);
+    return glfwGetTime();
 }
\ No newline at end of file
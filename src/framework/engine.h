@@ -4,12 +4,25 @@
 #include <vector>
 #include <memory>
 #include <iostream>
+#include <random>
 #include <GLFW/glfw3.h>
 
 #include "shaderManager.h"
 #include "../shapes/rect.h"
 #include "../shapes/shape.h"
 #include "fontRenderer.h"
+#include "textLayout.h"
+#include "particleRenderer.h"
+#include "particleSystem.h"
+#include "jobSystem.h"
+#include "config.h"
+#include "framebuffer.h"
+#include "simulation.h"
+#include "logoField.h"
+#include "profiler.h"
+#include "trace.h"
+#include "input.h"
+#include "inputLog.h"
 
 using std::vector, std::unique_ptr, std::make_unique, glm::ortho, glm::mat4, glm::vec3, glm::vec4;
 
@@ -22,12 +35,38 @@ class Engine {
         /// @brief The actual GLFW window.
         GLFWwindow* window{};
 
+        /// @brief Startup options (headless mode, frame count, confetti capacity, ...).
+        EngineConfig config;
+
+        /// @brief Offscreen render target used instead of the window in headless mode.
+        /// @details Initialized in initWindow() (headless mode only)
+        unique_ptr<Framebuffer> framebuffer;
+
+        /// @brief Number of frames rendered so far (drives the clock in headless mode).
+        unsigned int framesRendered = 0;
+
         /// @brief The width and height of the window.
-        const unsigned int WIDTH = 800, HEIGHT = 600; // Window dimensions
+        static const unsigned int WIDTH = 800, HEIGHT = 600; // Window dimensions
+
+        /// @brief The bouncing logo and its walls/corners counters, advanced in fixed ticks.
+        /// @details The dvd Rect only mirrors the simulation's logo for drawing.
+        Simulation simulation;
+
+        /// @brief Length of one simulation tick in seconds (1 / config.tickRate).
+        float tickTime;
 
-        /// @brief Keyboard state (True if pressed, false if not pressed).
-        /// @details Index this array with GLFW_KEY_{key} to get the state of a key.
-        bool keys[1024];
+        /// @brief Real time that has passed but not yet been simulated (always less than one tick after update()).
+        double accumulator = 0.0;
+
+        /// @brief The logo's position before the most recent tick, used to interpolate between ticks when rendering.
+        dvec2 previousPos;
+
+        /// @brief Direction of the arrow keys held this frame; applied to the logo's velocity every tick.
+        vec2 steering;
+
+        /// @brief Keyboard and mouse button state, updated by GLFW's callbacks.
+        /// @details Attached to the window in initWindow()
+        Input input;
 
         /// @brief Responsible for loading and storing all the shaders used in the project.
         /// @details Initialized in initShaders()
@@ -37,27 +76,114 @@ class Engine {
         /// @details Initialized in initShaders()
         unique_ptr<FontRenderer> fontRenderer;
 
+        /// @brief Pre-laid-out labels for the play and pause screens.
+        /// @details Initialized in initShaders()
+        unique_ptr<TextLayout> pauseLabel, returnLabel, wallsLabel, cornersLabel;
+
+        /// @brief The counter values wallsLabel and cornersLabel currently show.
+        long long wallsShown = 0, cornersShown = 0;
+
+        /// @brief Responsible for drawing all confetti in a single instanced draw call.
+        /// @details Initialized in initShaders()
+        unique_ptr<ParticleRenderer> particleRenderer;
+
+        /// @brief Worker threads used to split up per-particle work.
+        /// @details Initialized in the constructor
+        unique_ptr<JobSystem> jobSystem;
+
+        /// @brief The colliding logos shown instead of the single logo in multi-logo mode (config.logoCount > 0).
+        /// @details Initialized in the constructor (multi-logo mode only)
+        unique_ptr<LogoField> logoField;
+
+        /// @brief Draws every logo of logoField in a single instanced draw call.
+        /// @details Initialized in initShaders() (multi-logo mode only)
+        unique_ptr<ParticleRenderer> logoRenderer;
+
         // Shapes
         unique_ptr<Rect> dvd;
-        vector<unique_ptr<Rect>> confetti;
+        /// @brief Fixed-capacity pool holding every live confetti.
+        ParticleSystem confetti;
 
         // Shaders
         Shader shapeShader;
         Shader textShader;
+        Shader particleShader;
 
         double mouseX, mouseY;
-        bool mousePressedLastFrame = false;
+
+        /// @brief Random generator for confetti and click colors, seeded from config.seed so runs can be replayed.
+        std::mt19937 rng;
+
+        /// @brief Writes every frame's input and delta time to config.recordPath (null when not recording).
+        unique_ptr<InputRecorder> recorder;
+
+        /// @brief Feeds the frames of config.replayPath to the engine instead of GLFW (null when not replaying).
+        /// @details A replay has no window: processInput() reads the next frame from the log and render() does nothing.
+        unique_ptr<InputReplay> replay;
+        bool replayFinished = false;
+
+        /// @brief The corners count last printed by reportCorners().
+        long long cornersReported = 0;
+
+        /// @brief Returns a random integer in [0, n).
+        int random(int n);
+
+        /// @brief Returns a random opaque color with each channel a multiple of 0.1.
+        color randomColor();
+
+        /// @brief Replay: prints the corners hit since the last call, with the wall-clock time they happened at in the recording.
+        void reportCorners();
+
+        /// @brief Replay: prints the final counters and whether they match the recording.
+        void reportReplay();
+
+        /// @brief Times every phase of the frame and counts draw calls and uniform uploads for the HUD.
+        /// @details GPU timers are started in initWindow() once there is a context
+        Profiler profiler;
+
+        /// @brief Whether the performance HUD is drawn (toggled with F3).
+        bool hudVisible = false;
+
+        /// @brief Records the frame's spans for a Chrome trace when config.tracePath is set (null otherwise).
+        /// @details Initialized in the constructor; written at exit and whenever F4 is pressed
+        unique_ptr<TraceRecorder> trace;
+
+        /// @brief When the current frame started (its processInput()), for the trace's per-frame span.
+        TraceRecorder::Clock::time_point frameStart;
+
+        /// @brief Destroys a window whose setup failed part way, so the engine behaves as if it had none.
+        void destroyWindow();
+
+        /// @brief Writes the trace to config.tracePath.
+        void writeTrace();
+
+        /// @brief Queues the performance HUD's text (frame time, phase timings and counters) for the next flush.
+        void drawHud();
 
     public:
         /// @brief Constructor for the Engine class.
         /// @details Initializes window and shaders.
-        Engine();
+        /// @param config Startup options (see EngineConfig)
+        explicit Engine(const EngineConfig &config = EngineConfig());
 
         /// @brief Destructor for the Engine class.
         ~Engine();
 
+        /// @brief Creates the simulation the screensaver starts with: a 50x30 logo in the middle of the window.
+        /// @details Needs no window or GL context, so batch jobs can run the same simulation the screen shows.
+        /// @param config Startup options (the step mode is taken from it)
+        static Simulation createSimulation(const EngineConfig &config);
+
+        /// @brief Advances the single-logo simulation by seconds without rendering or ticking (see Simulation::fastForward()).
+        /// @note Multi-logo mode is not affected: collisions have no closed form.
+        /// @param seconds Seconds to skip
+        /// @return The number of corners hit
+        long long fastForward(double seconds);
+
         /// @brief Initializes the GLFW window.
-        /// @return 0 if successful, -1 otherwise.
+        /// @details In headless mode the window is hidden (on GLFW's null platform with an OSMesa
+        /// context when available) and rendering goes to an offscreen framebuffer instead.
+        /// @return 0 if successful, -1 otherwise (the window is destroyed again if it was created).
         unsigned int initWindow(bool debug = false);
 
         /// @brief Loads shaders from files and stores them in the shaderManager.
@@ -69,9 +195,11 @@ class Engine {
 
         /// @brief Processes input from the user.
         /// @details (e.g. keyboard input, mouse input, etc.)
+        /// Starts a new frame for the profiler, since it is the first thing the main loop runs every frame.
         void processInput();
 
-        /// @brief Pushes back a new colored rectangle to the confetti vector.
+        /// @brief Spawns a burst of colored particles into the confetti particle system.
+        /// @details Reuses free slots in the confetti pool; nothing is allocated. Confetti that doesn't fit is skipped.
         void spawnConfetti();
 
         /// @brief Updates the game state.
@@ -82,13 +210,14 @@ class Engine {
         /// @details Displays/renders objects on the screen.
         void render();
 
+        /// @brief Advances the simulation by one fixed tick.
+        /// @details Applies the held arrow keys, moves the logo (spawning confetti for every corner hit) and moves the confetti.
+        /// @param deltaTime Length of the tick in seconds
+        void tick(float deltaTime);
+
         /* deltaTime variables */
         float deltaTime = 0.0f; // Time between current frame and last frame
-        float lastFrame = 0.0f; // Time of last frame (used to calculate deltaTime)
-
-        // Keep track of walls and corners
-        int wallsHit = 0;
-        int cornersHit = 0;
+        double lastFrame = 0.0; // Time of last frame (used to calculate deltaTime)
 
         // Boolean to determine if confetti items are present on the screen
         bool confettiOnScreen = false;
@@ -99,25 +228,37 @@ class Engine {
 
         /// @brief Returns true if the window should close.
         /// @details (Wrapper for glfwWindowShouldClose()).
+        /// @details In headless mode this becomes true once the configured number of frames has been rendered,
+        /// and in a replay once the log has no frames left.
         /// @return true if the window should close
         /// @return false if the window should not close
         bool shouldClose();
 
+        /// @brief Returns the number of walls the logo has hit.
+        long long getWallsHit() const;
+
+        /// @brief Returns the number of corners the logo has hit.
+        long long getCornersHit() const;
+
+        /// @brief Returns the current time in seconds.
+        /// @details Wall-clock time (glfwGetTime()) normally; in headless mode frames are generated as fast as
+        /// possible, so time advances by exactly 1 / frameRate per rendered frame instead.
+        double getTime() const;
+
         /// Projection matrix used for 2D rendering (orthographic projection).
         /// We don't have to change this matrix since the screen size never changes.
         /// OpenGL uses the projection matrix to map the 3D scene to a 2D viewport.
         /// The projection matrix transforms coordinates in the camera space into normalized device coordinates (view space to clip space).
-        /// @note The projection matrix is used in the vertex shader.
+        /// @note The projection matrix is used in the vertex shader, which reads it from the "Frame" uniform block
+        /// uploaded once per frame in render().
         // 1st quadrant
         mat4 PROJECTION = ortho(0.0f, static_cast<float>(WIDTH), 0.0f, static_cast<float>(HEIGHT), -1.0f, 1.0f);
         // 4th quadrant
         // mat4 PROJECTION = ortho(0.0f, static_cast<float>(WIDTH), static_cast<float>(HEIGHT), 0.0f, -1.0f, 1.0f);
 
-        /// @brief Prevents dvd from going off screen
-        void checkBounds(unique_ptr<Rect> &dvd);
-
-        /// @brief Updates the position of the confetti pieces
-        void checkConfettiBounds(unique_ptr<Rect> &confetti);
+        /// @brief Updates the position of the confetti pieces and removes the ones that left the screen
+        /// @param deltaTime Length of the tick in seconds
+        void checkConfettiBounds(float deltaTime);
 
 };
 
@@ -2,6 +2,7 @@
 #include <glad/glad.h>
 
 #include <iostream>
+#include <vector>
 
 Font::Font(std::string fontPath, unsigned int fontSize) {
     FT_Library ft;
@@ -25,7 +26,11 @@ Font::Font(std::string fontPath, unsigned int fontSize) {
         std::cout << "ERROR::FREETYTPE: Failed to load Glyph" << std::endl;
     }
 
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // disable byte-alignment restriction
+    // Glyph bitmaps packed row by row into the atlas, plus where each glyph landed
+    std::vector<unsigned char> pixels;
+    std::vector<glm::ivec2> offsets(128);
+    int penX = 0, penY = 0, rowHeight = 0;
+    const int padding = 1; // keeps linear filtering from bleeding neighbouring glyphs into each other
 
     // Load first 128 characters of ASCII set
     for (unsigned char c = 0; c < 128; c++) {
@@ -35,37 +40,72 @@ Font::Font(std::string fontPath, unsigned int fontSize) {
             continue;
         }
 
-        // generate texture
-        unsigned int texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RED,
-            face->glyph->bitmap.width,
-            face->glyph->bitmap.rows,
-            0,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            face->glyph->bitmap.buffer
-        );
-
-        // set texture options
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        // now store character for later use
+        FT_Bitmap &bitmap = face->glyph->bitmap;
+        int width = bitmap.width, rows = bitmap.rows;
+
+        // start a new row when the glyph doesn't fit on the current one
+        if (penX + width + padding > ATLAS_WIDTH) {
+            penX = 0;
+            penY += rowHeight + padding;
+            rowHeight = 0;
+        }
+        if (pixels.size() < size_t(penY + rows) * ATLAS_WIDTH)
+            pixels.resize(size_t(penY + rows) * ATLAS_WIDTH, 0);
+
+        // copy the glyph into the atlas (pitch may be wider than the glyph)
+        for (int row = 0; row < rows; row++) {
+            for (int col = 0; col < width; col++) {
+                pixels[size_t(penY + row) * ATLAS_WIDTH + penX + col] = bitmap.buffer[row * bitmap.pitch + col];
+            }
+        }
+        offsets[c] = glm::ivec2(penX, penY);
+
+        // now store character for later use (UVs are filled in once the atlas height is known)
         Character character = {
-            texture,
-            glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
+            glm::vec2(0.0f),
+            glm::vec2(0.0f),
+            glm::ivec2(width, rows),
             glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
             static_cast<unsigned int>(face->glyph->advance.x)
         };
         Characters.insert(std::pair<char, Character>(c, character));
+
+        penX += width + padding;
+        rowHeight = rows > rowHeight ? rows : rowHeight;
+    }
+
+    int atlasHeight = penY + rowHeight > 0 ? penY + rowHeight : 1;
+    pixels.resize(size_t(atlasHeight) * ATLAS_WIDTH, 0);
+
+    for (auto &iter : Characters) {
+        glm::ivec2 offset = offsets[static_cast<unsigned char>(iter.first)];
+        Character &ch = iter.second;
+        ch.UVMin = glm::vec2(float(offset.x) / ATLAS_WIDTH, float(offset.y) / atlasHeight);
+        ch.UVMax = glm::vec2(float(offset.x + ch.Size.x) / ATLAS_WIDTH, float(offset.y + ch.Size.y) / atlasHeight);
     }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // disable byte-alignment restriction
+
+    // generate the atlas texture
+    glGenTextures(1, &Atlas);
+    glBindTexture(GL_TEXTURE_2D, Atlas);
+    glTexImage2D(
+        GL_TEXTURE_2D,
+        0,
+        GL_RED,
+        ATLAS_WIDTH,
+        atlasHeight,
+        0,
+        GL_RED,
+        GL_UNSIGNED_BYTE,
+        pixels.data()
+    );
+
+    // set texture options
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glBindTexture(GL_TEXTURE_2D, 0);
 
     FT_Done_Face(face);
@@ -74,4 +114,8 @@ Font::Font(std::string fontPath, unsigned int fontSize) {
 
 std::map<char, Character> Font::getCharacters() const {
     return Characters;
+}
+
+unsigned int Font::getAtlas() const {
+    return Atlas;
 }
\ No newline at end of file
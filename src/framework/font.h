@@ -14,13 +14,15 @@
  * @brief A single character
  * @details This struct is used to store information about a single character
  * 
- * @param TextureID ID handle of the glyph texture
+ * @param UVMin Texture coordinates of the glyph's top-left corner in the font atlas
+ * @param UVMax Texture coordinates of the glyph's bottom-right corner in the font atlas
  * @param Size Size of glyph
  * @param Bearing Offset from baseline to left/top of glyph
  * @param Advance Offset to advance to next glyph
  */
 struct Character {
-    unsigned int TextureID;
+    glm::vec2    UVMin;
+    glm::vec2    UVMax;
     glm::ivec2   Size;
     glm::ivec2   Bearing;
     unsigned int Advance;
@@ -28,7 +30,8 @@ struct Character {
 
 /**
  * @brief A font
- * @details This class is used to store information about a font
+ * @details This class is used to store information about a font.
+ * Every glyph is packed into a single texture (the atlas), so a whole string can be drawn with one texture bound.
  */
 class Font {
     public:
@@ -48,12 +51,30 @@ class Font {
          */
         std::map<char, Character> getCharacters() const;
 
+        /**
+         * @brief Get the atlas texture holding every glyph
+         * @details The texture is owned by the caller once the font has been loaded
+         *
+         * @return the atlas texture ID
+         */
+        unsigned int getAtlas() const;
+
     private:
         /**
          * @brief A set of character structs mapped to their ASCII character representations
          */
         std::map<char, Character> Characters;
 
+        /**
+         * @brief ID handle of the atlas texture (single red channel)
+         */
+        unsigned int Atlas = 0;
+
+        /**
+         * @brief Width of the atlas texture in pixels; glyphs are packed into rows this wide
+         */
+        static const int ATLAS_WIDTH = 512;
+
 };
 
 #endif //GRAPHICS_FONT_H
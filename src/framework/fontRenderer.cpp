@@ -1,73 +1,103 @@
 #include "fontRenderer.h"
+#include "profiler.h"
 
 #include "glad/glad.h"
 
-FontRenderer::FontRenderer(Shader& shader, std::string fontPath, int fontSize) {
+FontRenderer::FontRenderer(Shader& shader, std::string fontPath, int fontSize) : stream(GL_ARRAY_BUFFER, STREAM_SIZE) {
     this->shader = shader;
     this->initRenderData();
     Font myFont(fontPath, fontSize);
-    this->font = myFont.getCharacters();
+    for (const auto &iter : myFont.getCharacters())
+        this->font[static_cast<unsigned char>(iter.first)] = iter.second;
+    this->atlas = myFont.getAtlas();
 }
 
 FontRenderer::~FontRenderer() {
     glDeleteVertexArrays(1, &this->VAO);
-    glDeleteBuffers(1, &this->VBO);
+    glDeleteTextures(1, &this->atlas);
 }
 
 void FontRenderer::initRenderData() {
     glGenVertexArrays(1, &this->VAO);
-    glGenBuffers(1, &this->VBO);
     glBindVertexArray(this->VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
+    glBindBuffer(GL_ARRAY_BUFFER, this->stream.getBuffer());
+    initVertexAttributes();
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
 }
 
-void FontRenderer::renderText(std::string text, float x, float y, float scale, glm::vec3 color) {
-    // activate corresponding render state
+void FontRenderer::initVertexAttributes() {
+    // <vec2 pos, vec2 tex> at location 0 and <vec3 color> at location 1
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(float), 0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, VERTEX_SIZE * sizeof(float), (void*)(4 * sizeof(float)));
+}
 
+void FontRenderer::use() {
     this->shader.use();
-    glUniformMatrix4fv(glGetUniformLocation(this->shader.ID, "projection"), 1, false, glm::value_ptr(projection));
-    glUniform3f(glGetUniformLocation(this->shader.ID, "textColor"), color.x, color.y, color.z);
-
     glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(this->VAO);
+    glBindTexture(GL_TEXTURE_2D, this->atlas);
+}
 
+void FontRenderer::renderText(const std::string &text, float x, float y, float scale, glm::vec3 color) {
+    layoutText(text, x, y, scale, color, vertices);
+}
+
+void FontRenderer::layoutText(const std::string &text, float x, float y, float scale, glm::vec3 color,
+                              std::vector<float> &out) const {
     // iterate through all characters
     std::string::const_iterator c;
     for (c = text.begin(); c != text.end(); c++) {
-        Character ch = font[*c];
+        unsigned char code = static_cast<unsigned char>(*c);
+        if (code >= font.size())
+            continue; // the font only has the ASCII set
+        const Character &ch = font[code];
 
         float xpos = x + ch.Bearing.x * scale;
         float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
 
         float w = ch.Size.x * scale;
         float h = ch.Size.y * scale;
-        // update VBO for each character
-        float vertices[6][4] = {
-            { xpos,     ypos + h,   0.0f, 0.0f },            
-            { xpos,     ypos,       0.0f, 1.0f },
-            { xpos + w, ypos,       1.0f, 1.0f },
-
-            { xpos,     ypos + h,   0.0f, 0.0f },
-            { xpos + w, ypos,       1.0f, 1.0f },
-            { xpos + w, ypos + h,   1.0f, 0.0f }           
+        // queue the glyph's quad, textured with its rectangle in the atlas
+        float quad[6][VERTEX_SIZE] = {
+            { xpos,     ypos + h,   ch.UVMin.x, ch.UVMin.y, color.x, color.y, color.z },
+            { xpos,     ypos,       ch.UVMin.x, ch.UVMax.y, color.x, color.y, color.z },
+            { xpos + w, ypos,       ch.UVMax.x, ch.UVMax.y, color.x, color.y, color.z },
+
+            { xpos,     ypos + h,   ch.UVMin.x, ch.UVMin.y, color.x, color.y, color.z },
+            { xpos + w, ypos,       ch.UVMax.x, ch.UVMax.y, color.x, color.y, color.z },
+            { xpos + w, ypos + h,   ch.UVMax.x, ch.UVMin.y, color.x, color.y, color.z }
         };
-        // render glyph texture over quad
-        glBindTexture(GL_TEXTURE_2D, ch.TextureID);
-        // update content of VBO memory
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices); 
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        // render quad
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        out.insert(out.end(), &quad[0][0], &quad[0][0] + 6 * VERTEX_SIZE);
+
         // now advance cursors for next glyph (note that advance is number of 1/64 pixels)
         x += (ch.Advance >> 6) * scale; // bitshift by 6 to get value in pixels (2^6 = 64)
     }
+}
+
+void FontRenderer::flush() {
+    if (vertices.empty())
+        return;
+
+    // activate corresponding render state
+    this->use();
+    glBindVertexArray(this->VAO);
+
+    // upload every queued glyph at once into the next free region of the ring, aligned to a whole vertex
+    // so it can be drawn from by vertex index (the buffer can change if the ring had to grow)
+    size_t stride = VERTEX_SIZE * sizeof(float);
+    size_t offset = stream.append(vertices.data(), vertices.size() * sizeof(float), stride);
+    glBindBuffer(GL_ARRAY_BUFFER, stream.getBuffer());
+    initVertexAttributes();
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // render every quad
+    glDrawArrays(GL_TRIANGLES, offset / stride, vertices.size() / VERTEX_SIZE);
+    Profiler::countDrawCall();
+    stream.fence();
+    vertices.clear();
 
     glBindVertexArray(0);
     glBindTexture(GL_TEXTURE_2D, 0);
-}
\ No newline at end of file
+}
@@ -1,13 +1,20 @@
 #ifndef FONTRENDERER_H
 #define FONTRENDERER_H
 
+#include <array>
+#include <vector>
+
 #include "shaderManager.h"
 #include "shader.h"
 #include "font.h"
+#include "streamBuffer.h"
 
 /**
  * @brief A font renderer
- * @details This class is used to render text using a font
+ * @details This class is used to render text using a font.
+ * Text is batched: renderText() only builds the glyph quads, and flush() draws every quad queued
+ * since the last flush with the font atlas bound, in a single draw call. The quads are streamed
+ * through a StreamBuffer, so a flush never waits on the GPU to finish drawing the previous frame's text.
  */
 class FontRenderer {
     public:
@@ -23,12 +30,12 @@ class FontRenderer {
 
         /**
          * @brief Destroy the Font Renderer object
-         * @details destroys the VAO and VBO associated with the font renderer
+         * @details destroys the VAO, stream buffer and atlas texture associated with the font renderer
          */
         ~FontRenderer();
 
         /**
-         * @brief Renders text on the screen
+         * @brief Queues text to be rendered on the screen by the next flush()
          * 
          * @param text The text to render
          * @param x The x position of the text
@@ -36,7 +43,48 @@ class FontRenderer {
          * @param scale The scale of the text
          * @param color The color of the text
          */
-        void renderText(std::string text, float x, float y, float scale, glm::vec3 color);
+        void renderText(const std::string &text, float x, float y, float scale, glm::vec3 color);
+
+        /**
+         * @brief Appends the glyph quads for a string to a vertex array
+         * @details Shared by renderText() and TextLayout. Each glyph adds 6 vertices of VERTEX_SIZE floats.
+         *
+         * @param text The text to lay out
+         * @param x The x position of the text
+         * @param y The y position of the text
+         * @param scale The scale of the text
+         * @param color The color of the text
+         * @param out The vertex array to append to
+         */
+        void layoutText(const std::string &text, float x, float y, float scale, glm::vec3 color,
+                        std::vector<float> &out) const;
+
+        /**
+         * @brief Activates the text shader and binds the font atlas
+         * @details Used by flush() and TextLayout::draw()
+         */
+        void use();
+
+        /**
+         * @brief Configures the vertex attributes of a text vertex buffer on the bound VAO
+         */
+        static void initVertexAttributes();
+
+        /**
+         * @brief Draws all text queued since the last flush in one draw call
+         * @details Call once per frame after the last renderText()
+         */
+        void flush();
+
+        /**
+         * @brief Number of floats per text vertex: <vec2 pos, vec2 tex, vec3 color>
+         */
+        static const int VERTEX_SIZE = 7;
+
+        /**
+         * @brief Initial size of the stream buffer in bytes (room for a few frames of about 500 glyphs)
+         */
+        static const size_t STREAM_SIZE = 256 * 1024;
 
     private:
         /**
@@ -45,20 +93,30 @@ class FontRenderer {
         Shader shader;
 
         /**
-         * @brief The VAO and VBO associated with the font renderer
+         * @brief The VAO associated with the font renderer
+         */
+        GLuint VAO;
+
+        /**
+         * @brief The ring buffer the queued quads are uploaded into
+         */
+        StreamBuffer stream;
+
+        /**
+         * @brief The texture every glyph is packed into
          */
-        GLuint VAO, VBO;
+        GLuint atlas;
 
         /**
-         * @brief The projection matrix
+         * @brief Vertices queued by renderText() and not yet drawn
          */
-        glm::mat4 projection = glm::ortho(0.0f, 800.0f, 0.0f, 600.0f); // TODO: decide if this should be here or constant in engine class
+        std::vector<float> vertices;
 
         /**
-         * @brief A set of character structs mapped to their ASCII character representations
-         * @details This is the same map generated by the font class
+         * @brief A set of character structs indexed by their ASCII character representations
+         * @details Copied out of the map generated by the font class so lookups are a plain array index
          */
-        std::map<char, Character> font;
+        std::array<Character, 128> font{};
 
         /**
          * @brief Initializes and configures the buffer and vertex attributes
@@ -0,0 +1,66 @@
+#ifndef GRAPHICS_FRAMEBUFFER_H
+#define GRAPHICS_FRAMEBUFFER_H
+
+#include <string>
+#include <vector>
+#include <glad/glad.h>
+
+/**
+ * @brief An offscreen render target
+ * @details Wraps a framebuffer object with an RGBA color renderbuffer. Used in headless mode,
+ * where there is no window to present to.
+ */
+class Framebuffer {
+    public:
+        /**
+         * @brief Construct a new Framebuffer object
+         *
+         * @param width The width of the render target in pixels
+         * @param height The height of the render target in pixels
+         */
+        Framebuffer(unsigned int width, unsigned int height);
+
+        /**
+         * @brief Destroy the Framebuffer object
+         * @details destroys the FBO and its renderbuffer
+         */
+        ~Framebuffer();
+
+        Framebuffer(const Framebuffer&) = delete;
+        Framebuffer& operator=(const Framebuffer&) = delete;
+
+        /**
+         * @brief Directs all drawing into this framebuffer
+         */
+        void bind() const;
+
+        /**
+         * @brief Returns true if the framebuffer was created successfully
+         */
+        bool isComplete() const;
+
+        /**
+         * @brief Reads the framebuffer back and writes it to a PNG file
+         *
+         * @param path The file to write
+         * @return true if the file was written
+         */
+        bool savePNG(const std::string &path);
+
+    private:
+        /**
+         * @brief The framebuffer object and its color renderbuffer
+         */
+        GLuint FBO, colorBuffer;
+
+        unsigned int width, height;
+
+        bool complete = false;
+
+        /**
+         * @brief Scratch buffer the pixels are read back into (reused between frames)
+         */
+        std::vector<unsigned char> pixels;
+};
+
+#endif //GRAPHICS_FRAMEBUFFER_H
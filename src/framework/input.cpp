@@ -0,0 +1,63 @@
+#include "input.h"
+
+void Input::attach(GLFWwindow *window) {
+    glfwSetWindowUserPointer(window, this);
+    glfwSetKeyCallback(window, keyCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+}
+
+void Input::beginFrame() {
+    keysPressed.reset();
+    keysReleased.reset();
+    buttonsPressed.reset();
+    buttonsReleased.reset();
+    events.clear();
+}
+
+void Input::onKey(int key, int action) {
+    if (key < 0 || key >= KEY_COUNT)
+        return;
+
+    if (action == GLFW_PRESS) {
+        keysDown.set(key);
+        keysPressed.set(key);
+    } else if (action == GLFW_RELEASE) {
+        keysDown.reset(key);
+        keysReleased.set(key);
+    } else {
+        return;
+    }
+    events.push_back({Key, uint8_t(action), uint16_t(key)});
+}
+
+void Input::onMouseButton(int button, int action) {
+    if (button < 0 || button >= BUTTON_COUNT)
+        return;
+
+    if (action == GLFW_PRESS) {
+        buttonsDown.set(button);
+        buttonsPressed.set(button);
+    } else if (action == GLFW_RELEASE) {
+        buttonsDown.reset(button);
+        buttonsReleased.set(button);
+    } else {
+        return;
+    }
+    events.push_back({MouseButton, uint8_t(action), uint16_t(button)});
+}
+
+void Input::keyCallback(GLFWwindow *window, int key, int, int action, int) {
+    static_cast<Input*>(glfwGetWindowUserPointer(window))->onKey(key, action);
+}
+
+void Input::mouseButtonCallback(GLFWwindow *window, int button, int action, int) {
+    static_cast<Input*>(glfwGetWindowUserPointer(window))->onMouseButton(button, action);
+}
+
+bool Input::isKeyDown(int key) const            { return key >= 0 && key < KEY_COUNT && keysDown.test(key); }
+bool Input::wasKeyPressed(int key) const        { return key >= 0 && key < KEY_COUNT && keysPressed.test(key); }
+bool Input::wasKeyReleased(int key) const       { return key >= 0 && key < KEY_COUNT && keysReleased.test(key); }
+bool Input::isButtonDown(int button) const      { return button >= 0 && button < BUTTON_COUNT && buttonsDown.test(button); }
+bool Input::wasButtonPressed(int button) const  { return button >= 0 && button < BUTTON_COUNT && buttonsPressed.test(button); }
+bool Input::wasButtonReleased(int button) const { return button >= 0 && button < BUTTON_COUNT && buttonsReleased.test(button); }
+const std::vector<Input::Event> &Input::getEvents() const { return events; }
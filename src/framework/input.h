@@ -0,0 +1,77 @@
+#ifndef GRAPHICS_INPUT_H
+#define GRAPHICS_INPUT_H
+
+#include <bitset>
+#include <cstdint>
+#include <vector>
+#include <GLFW/glfw3.h>
+
+/**
+ * @brief Event-driven keyboard and mouse button state
+ * @details GLFW's key and mouse button callbacks feed onKey() and onMouseButton(), which keep three bitsets per
+ * device: what is held down, what went down this frame and what came up this frame. The engine reads those instead
+ * of asking GLFW for every key every frame. A key pressed and released between two frames still shows up as pressed
+ * (and released) for one frame, so quick taps and clicks are never missed. The transitions are also kept in order
+ * (getEvents()), which is what an InputRecorder writes out.
+ */
+class Input {
+    public:
+        /// @brief Number of key codes and mouse buttons GLFW can report
+        static const int KEY_COUNT = GLFW_KEY_LAST + 1;
+        static const int BUTTON_COUNT = GLFW_MOUSE_BUTTON_LAST + 1;
+
+        /// @brief Which device an Event came from
+        enum Device : uint8_t { Key, MouseButton };
+
+        /// @brief One press or release, in the order they arrived
+        struct Event {
+            uint8_t device;
+            uint8_t action;
+            uint16_t code;
+        };
+
+        /// @brief Installs the key and mouse button callbacks on a window
+        /// @details Uses the window's user pointer to find this object from the callbacks.
+        void attach(GLFWwindow *window);
+
+        /// @brief Forgets the previous frame's transitions
+        /// @details Call once per frame before glfwPollEvents().
+        void beginFrame();
+
+        /// @brief Applies a key transition (from the key callback)
+        /// @param key GLFW_KEY_{key}; unknown keys are ignored
+        /// @param action GLFW_PRESS or GLFW_RELEASE (GLFW_REPEAT changes nothing)
+        void onKey(int key, int action);
+
+        /// @brief Applies a mouse button transition (from the mouse button callback)
+        /// @param button GLFW_MOUSE_BUTTON_{button}
+        /// @param action GLFW_PRESS or GLFW_RELEASE
+        void onMouseButton(int button, int action);
+
+        // --------------------------------------------------------
+        // Getters
+        // --------------------------------------------------------
+        /// @brief Returns true while the key is held
+        bool isKeyDown(int key) const;
+        /// @brief Returns true if the key went down since beginFrame()
+        bool wasKeyPressed(int key) const;
+        /// @brief Returns true if the key came up since beginFrame()
+        bool wasKeyReleased(int key) const;
+
+        bool isButtonDown(int button) const;
+        bool wasButtonPressed(int button) const;
+        bool wasButtonReleased(int button) const;
+
+        /// @brief Every press and release since beginFrame(), in order
+        const std::vector<Event> &getEvents() const;
+
+    private:
+        std::bitset<KEY_COUNT> keysDown, keysPressed, keysReleased;
+        std::bitset<BUTTON_COUNT> buttonsDown, buttonsPressed, buttonsReleased;
+        std::vector<Event> events;
+
+        static void keyCallback(GLFWwindow *window, int key, int scancode, int action, int mods);
+        static void mouseButtonCallback(GLFWwindow *window, int button, int action, int mods);
+};
+
+#endif //GRAPHICS_INPUT_H
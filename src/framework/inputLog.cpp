@@ -0,0 +1,151 @@
+#include "inputLog.h"
+
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+using std::cout, std::endl;
+
+static const char MAGIC[4] = {'D', 'V', 'D', 'L'};
+
+template <typename T>
+static void writeValue(std::ofstream &file, T value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static bool readValue(std::ifstream &file, T &value) {
+    return bool(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+/// @brief Reads and checks a header, filling in the recorded settings
+static bool readHeader(std::ifstream &file, EngineConfig &config, int64_t &startTime) {
+    char magic[4];
+    uint32_t version, seed, logoCount, confettiCapacity;
+    float tickRate;
+    uint8_t eventStepping;
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        !readValue(file, version) || version != InputLog::VERSION)
+        return false;
+    if (!readValue(file, seed) || !readValue(file, tickRate) || !readValue(file, eventStepping) ||
+        !readValue(file, logoCount) || !readValue(file, confettiCapacity) || !readValue(file, startTime))
+        return false;
+
+    config.seed = seed;
+    config.tickRate = tickRate;
+    config.eventStepping = eventStepping != 0;
+    config.logoCount = logoCount;
+    config.confettiCapacity = confettiCapacity;
+    return tickRate > 0;
+}
+
+InputRecorder::InputRecorder(const std::string &path, const EngineConfig &config) : file(path, std::ios::binary) {
+    if (!file) {
+        cout << "ERROR::INPUT_LOG: Failed to create " << path << endl;
+        return;
+    }
+
+    file.write(MAGIC, sizeof(MAGIC));
+    writeValue<uint32_t>(file, InputLog::VERSION);
+    writeValue<uint32_t>(file, config.seed);
+    writeValue<float>(file, config.tickRate);
+    writeValue<uint8_t>(file, config.eventStepping ? 1 : 0);
+    writeValue<uint32_t>(file, config.logoCount);
+    writeValue<uint32_t>(file, config.confettiCapacity);
+    writeValue<int64_t>(file, std::time(nullptr));
+}
+
+bool InputRecorder::isOpen() const {
+    return file.is_open();
+}
+
+void InputRecorder::writeFrame(float deltaTime, const std::vector<Input::Event> &events) {
+    file.put(InputLog::FRAME);
+    writeValue<float>(file, deltaTime);
+
+    // More than 65535 transitions in one frame can't happen with real input; drop the excess rather than corrupt the log
+    uint16_t count = events.size() < 0xFFFF ? uint16_t(events.size()) : uint16_t(0xFFFF);
+    writeValue<uint16_t>(file, count);
+    for (uint16_t i = 0; i < count; i++) {
+        writeValue<uint8_t>(file, events[i].device);
+        writeValue<uint8_t>(file, events[i].action);
+        writeValue<uint16_t>(file, events[i].code);
+    }
+    frames++;
+
+    // Push the buffer out now and then, so a recording that is killed can still be replayed up to the last flush
+    unflushedTime += deltaTime;
+    if (unflushedTime >= InputLog::FLUSH_INTERVAL) {
+        file.flush();
+        unflushedTime = 0;
+    }
+}
+
+void InputRecorder::finish(long long wallsHit, long long cornersHit) {
+    file.put(InputLog::END);
+    writeValue<uint32_t>(file, frames);
+    writeValue<int64_t>(file, wallsHit);
+    writeValue<int64_t>(file, cornersHit);
+    file.close();
+}
+
+bool InputReplay::loadConfig(const std::string &path, EngineConfig &config) {
+    std::ifstream file(path, std::ios::binary);
+    int64_t startTime;
+    if (!file || !readHeader(file, config, startTime)) {
+        cout << "ERROR::INPUT_LOG: " << path << " is not a readable input log" << endl;
+        return false;
+    }
+    return true;
+}
+
+InputReplay::InputReplay(const std::string &path) : file(path, std::ios::binary) {
+    EngineConfig config;
+    open = file && readHeader(file, config, startTime);
+    if (!open)
+        cout << "ERROR::INPUT_LOG: " << path << " is not a readable input log" << endl;
+}
+
+bool InputReplay::isOpen() const {
+    return open;
+}
+
+bool InputReplay::nextFrame(Input &input) {
+    if (!open || finished)
+        return false;
+
+    int tag = file.get();
+    if (tag == InputLog::END) {
+        finished = true;
+        ended = readValue(file, recordedFrames) && readValue(file, recordedWallsHit) && readValue(file, recordedCornersHit);
+        return false;
+    }
+
+    uint16_t count;
+    if (tag != InputLog::FRAME || !readValue(file, deltaTime) || !readValue(file, count)) {
+        finished = true; // Truncated (the recording was killed) or corrupt: stop here
+        return false;
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        Input::Event event;
+        if (!readValue(file, event.device) || !readValue(file, event.action) || !readValue(file, event.code)) {
+            finished = true;
+            return false;
+        }
+        if (event.device == Input::Key)
+            input.onKey(event.code, event.action);
+        else
+            input.onMouseButton(event.code, event.action);
+    }
+    frames++;
+    return true;
+}
+
+float InputReplay::getDeltaTime() const             { return deltaTime; }
+int64_t InputReplay::getStartTime() const           { return startTime; }
+uint32_t InputReplay::getFrames() const             { return frames; }
+bool InputReplay::hasEnd() const                    { return ended; }
+uint32_t InputReplay::getRecordedFrames() const     { return recordedFrames; }
+long long InputReplay::getRecordedWallsHit() const   { return recordedWallsHit; }
+long long InputReplay::getRecordedCornersHit() const { return recordedCornersHit; }
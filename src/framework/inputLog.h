@@ -0,0 +1,116 @@
+#ifndef GRAPHICS_INPUTLOG_H
+#define GRAPHICS_INPUTLOG_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "input.h"
+
+/**
+ * @brief Binary log of everything that steers a run of the engine, for deterministic replay
+ * @details The header holds the settings the simulation depends on (random seed, tick rate, step mode, number of
+ * logos, confetti capacity) and the wall-clock time the recording started. Then comes one record per frame: the
+ * frame's delta time and the key and mouse button transitions processInput() saw. An end record holds the final
+ * walls and corners counts so a replay can check it reproduced them.
+ *
+ * Layout (native byte order):
+ * - header: "DVDL", uint32 version, uint32 seed, float tickRate, uint8 eventStepping, uint32 logoCount,
+ *   uint32 confettiCapacity, int64 startTime (Unix seconds)
+ * - frame: 'F', float deltaTime, uint16 eventCount, eventCount x (uint8 device, uint8 action, uint16 code)
+ * - end: 'E', uint32 frames, int64 wallsHit, int64 cornersHit
+ *
+ * A frame without input takes 7 bytes, so an hour at 60 fps is about 1.5 MB.
+ * The recorder flushes about once a second, so a killed recording loses at most its last second; its replay
+ * stops there and reports without an end record to compare with.
+ */
+namespace InputLog {
+    /// @brief Format version written to the header
+    const uint32_t VERSION = 2;
+
+    /// @brief Record tags
+    const char FRAME = 'F';
+    const char END = 'E';
+
+    /// @brief Seconds of recorded frames between flushes of the log to disk
+    const float FLUSH_INTERVAL = 1.0f;
+}
+
+/**
+ * @brief Writes an input log while the engine runs
+ */
+class InputRecorder {
+    public:
+        /// @brief Creates the log and writes its header
+        /// @param path The file to write
+        /// @param config The settings to record (seed, tick rate, step mode, logos, confetti capacity)
+        InputRecorder(const std::string &path, const EngineConfig &config);
+
+        /// @brief Returns false if the file could not be created
+        bool isOpen() const;
+
+        /// @brief Appends one frame: its delta time and the transitions seen before it
+        void writeFrame(float deltaTime, const std::vector<Input::Event> &events);
+
+        /// @brief Appends the end record with the final counters and closes the log
+        void finish(long long wallsHit, long long cornersHit);
+
+    private:
+        std::ofstream file;
+        uint32_t frames = 0;
+        float unflushedTime = 0;
+};
+
+/**
+ * @brief Reads an input log back one frame at a time
+ */
+class InputReplay {
+    public:
+        /// @brief Reads the settings stored in a log's header into config, so the engine starts the way the recording did
+        /// @return false (after printing an error) if the file can't be read or isn't an input log
+        static bool loadConfig(const std::string &path, EngineConfig &config);
+
+        /// @brief Opens a log and reads its header
+        explicit InputReplay(const std::string &path);
+
+        /// @brief Returns false if the file could not be opened or its header is invalid
+        /// @details Stays true after the last frame has been read, so the replay can still be reported.
+        bool isOpen() const;
+
+        /// @brief Reads the next frame and feeds its transitions to input
+        /// @return false once the log has no frames left (the end record, if any, has then been read)
+        bool nextFrame(Input &input);
+
+        // --------------------------------------------------------
+        // Getters
+        // --------------------------------------------------------
+        /// @brief Delta time of the frame read by the last nextFrame()
+        float getDeltaTime() const;
+        /// @brief Wall-clock time the recording started (Unix seconds)
+        int64_t getStartTime() const;
+        /// @brief Frames read so far
+        uint32_t getFrames() const;
+        /// @brief Whether the end record was read (false if the recording was cut short)
+        bool hasEnd() const;
+        uint32_t getRecordedFrames() const;
+        long long getRecordedWallsHit() const;
+        long long getRecordedCornersHit() const;
+
+    private:
+        std::ifstream file;
+        /// @brief Whether the header was valid
+        bool open = false;
+        /// @brief Whether the last frame has been read (at the end record, or where a cut short log stops)
+        bool finished = false;
+        int64_t startTime = 0;
+        float deltaTime = 0;
+        uint32_t frames = 0;
+
+        bool ended = false;
+        uint32_t recordedFrames = 0;
+        int64_t recordedWallsHit = 0, recordedCornersHit = 0;
+};
+
+#endif //GRAPHICS_INPUTLOG_H
@@ -0,0 +1,121 @@
+#include "jobSystem.h"
+
+JobSystem::JobSystem(unsigned int workerCount) {
+    for (unsigned int i = 0; i <= workerCount; i++)
+        queues.push_back(std::make_unique<Queue>());
+
+    // Queue 0 belongs to the calling thread, so workers start at index 1
+    for (unsigned int i = 1; i <= workerCount; i++)
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (std::thread &worker : workers)
+        worker.join();
+}
+
+unsigned int JobSystem::getWorkerCount() const {
+    return workers.size();
+}
+
+unsigned int JobSystem::defaultWorkerCount() {
+    unsigned int cores = std::thread::hardware_concurrency();
+    return cores > 1 ? cores - 1 : 0;
+}
+
+void JobSystem::parallelFor(size_t count, size_t chunkSize, const std::function<void(size_t, size_t)> &work) {
+    if (count == 0)
+        return;
+    if (chunkSize == 0)
+        chunkSize = count;
+
+    size_t chunks = (count + chunkSize - 1) / chunkSize;
+
+    // Nothing to share: run inline without touching the queues
+    if (chunks == 1 || workers.empty()) {
+        work(0, count);
+        return;
+    }
+
+    std::atomic<size_t> remaining(chunks);
+
+    // Count the jobs before queueing them, under the sleep mutex so no worker can miss the wake-up
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        pending += chunks;
+    }
+
+    // Deal the chunks out round-robin so every thread starts with its own share
+    for (size_t chunk = 0; chunk < chunks; chunk++) {
+        size_t begin = chunk * chunkSize;
+        size_t end = begin + chunkSize < count ? begin + chunkSize : count;
+        Queue &queue = *queues[chunk % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back({&work, begin, end, &remaining});
+    }
+
+    wake.notify_all();
+
+    // The calling thread works through its own queue and then helps the others until all chunks are done
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        Job job;
+        if (popLocal(0, job) || steal(0, job))
+            run(job);
+        else
+            std::this_thread::yield(); // The last chunks are still running on other threads
+    }
+}
+
+void JobSystem::workerLoop(size_t index) {
+    while (true) {
+        Job job;
+        if (popLocal(index, job) || steal(index, job)) {
+            run(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stopping || pending.load() > 0; });
+        if (stopping)
+            return;
+    }
+}
+
+bool JobSystem::popLocal(size_t index, Job &job) {
+    Queue &queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty())
+        return false;
+
+    job = queue.jobs.back();
+    queue.jobs.pop_back();
+    pending--;
+    return true;
+}
+
+bool JobSystem::steal(size_t thief, Job &job) {
+    // Start with the next queue over so thieves spread out instead of all hitting queue 0
+    for (size_t offset = 1; offset < queues.size(); offset++) {
+        Queue &queue = *queues[(thief + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty())
+            continue;
+
+        job = queue.jobs.front();
+        queue.jobs.pop_front();
+        pending--;
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::run(const Job &job) {
+    (*job.work)(job.begin, job.end);
+    job.remaining->fetch_sub(1, std::memory_order_release);
+}
@@ -0,0 +1,90 @@
+#ifndef GRAPHICS_JOBSYSTEM_H
+#define GRAPHICS_JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A fixed pool of worker threads with work-stealing job queues
+ * @details Every worker owns a deque of jobs. A worker pops jobs from the back of its own deque and,
+ * when that runs dry, steals from the front of the other deques. The thread that submits work
+ * (usually the render thread) takes part too, so a pool with no workers simply runs everything inline.
+ */
+class JobSystem {
+    public:
+        /// @brief Construct a new Job System object and start its workers
+        /// @param workerCount Number of worker threads (defaults to one less than the number of cores)
+        explicit JobSystem(unsigned int workerCount = defaultWorkerCount());
+
+        /// @brief Destroy the Job System object
+        /// @details Wakes every worker and joins it
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        /// @brief Splits [0, count) into chunks and runs work(begin, end) on each chunk across all threads
+        /// @details Blocks until every chunk has finished. Chunks never overlap, so work may write to
+        /// per-index data without locking.
+        /// @note Only one thread may call parallelFor at a time.
+        /// @param count The number of items
+        /// @param chunkSize The number of items per job
+        /// @param work The function to run on each chunk
+        void parallelFor(size_t count, size_t chunkSize, const std::function<void(size_t, size_t)> &work);
+
+        /// @brief Returns the number of worker threads (not counting the calling thread)
+        unsigned int getWorkerCount() const;
+
+        /// @brief Returns one less than the number of hardware threads (the caller is the last one)
+        static unsigned int defaultWorkerCount();
+
+    private:
+        /// @brief A chunk of a parallelFor call
+        struct Job {
+            const std::function<void(size_t, size_t)> *work;
+            size_t begin, end;
+            std::atomic<size_t> *remaining;
+        };
+
+        /// @brief A job deque and the mutex guarding it
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+        };
+
+        /// @brief One queue per worker, plus queue 0 for the thread calling parallelFor
+        std::vector<std::unique_ptr<Queue>> queues;
+
+        /// @brief The worker threads
+        std::vector<std::thread> workers;
+
+        /// @brief Number of jobs queued but not yet taken by a thread
+        std::atomic<size_t> pending{0};
+
+        /// @brief Set when the workers should exit
+        bool stopping = false;
+
+        /// @brief Used to put idle workers to sleep until new jobs are queued
+        std::mutex sleepMutex;
+        std::condition_variable wake;
+
+        /// @brief Main loop of each worker thread
+        void workerLoop(size_t index);
+
+        /// @brief Takes a job from the back of the given thread's own queue
+        bool popLocal(size_t index, Job &job);
+
+        /// @brief Takes a job from the front of any other thread's queue
+        bool steal(size_t thief, Job &job);
+
+        /// @brief Runs a job and marks it finished
+        static void run(const Job &job);
+};
+
+#endif //GRAPHICS_JOBSYSTEM_H
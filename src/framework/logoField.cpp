@@ -0,0 +1,296 @@
+#include "logoField.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+LogoField::LogoField(vec2 bounds, StepMode mode) : bounds(bounds), mode(mode) {}
+
+void LogoField::add(const Logo &logo, vec4 color) {
+    order.push_back(logos.size());
+    logos.push_back(logo);
+    reach.push_back(0);
+    colors.push_back(color);
+    x.push_back(logo.pos.x);
+    y.push_back(logo.pos.y);
+    width.push_back(logo.size.x);
+    height.push_back(logo.size.y);
+}
+
+void LogoField::scatter(size_t count, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(0, 1);
+    std::uniform_real_distribution<double> speed(50, 150);
+
+    logos.reserve(logos.size() + count);
+    for (size_t i = 0; i < count; i++) {
+        // Between a fifth and the full size of the single logo, keeping its 5:3 shape
+        float scale = 0.2f + 0.8f * unit(rng);
+        vec2 size = vec2(50, 30) * scale;
+
+        Logo logo;
+        logo.size = size;
+        logo.pos = dvec2(size.x / 2 + unit(rng) * (bounds.x - size.x), size.y / 2 + unit(rng) * (bounds.y - size.y));
+        logo.velocity = dvec2(unit(rng) < 0.5f ? -speed(rng) : speed(rng), unit(rng) < 0.5f ? -speed(rng) : speed(rng));
+        add(logo, vec4(unit(rng), unit(rng), unit(rng), 1.0f));
+    }
+}
+
+unsigned int LogoField::step(float deltaTime) {
+    if (mode == StepMode::Event)
+        return stepExact(deltaTime);
+
+    // Move every logo and bounce it off the walls with the same rules as the single logo
+    unsigned int corners = 0;
+    for (Logo &logo : logos)
+        corners += Simulation::checkBounds(logo, bounds, deltaTime, wallsHit, cornersHit);
+
+    // Broad phase, then narrow phase on the candidates only
+    sortByLeft();
+    findPairs();
+    for (const auto &pair : pairs) {
+        Logo &a = logos[pair.first], &b = logos[pair.second];
+        if (isOverlapping(a, b))
+            bounce(a, b);
+    }
+
+    for (size_t i = 0; i < logos.size(); i++) {
+        x[i] = logos[i].pos.x;
+        y[i] = logos[i].pos.y;
+    }
+    return corners;
+}
+
+unsigned int LogoField::stepExact(float deltaTime) {
+    size_t count = logos.size();
+
+    // Broad phase on the area each logo can sweep through this step
+    speedLimits.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        speedLimits[i] = glm::length(logos[i].velocity);
+        reach[i] = speedLimits[i] * deltaTime;
+    }
+    sortByLeft();
+    findPairs();
+
+    neighbors.resize(count);
+    for (auto &list : neighbors)
+        list.clear();
+    for (const auto &pair : pairs) {
+        neighbors[pair.first].push_back(pair.second);
+        neighbors[pair.second].push_back(pair.first);
+    }
+
+    times.assign(count, 0);
+    queue.reset(count);
+    for (unsigned int i = 0; i < count; i++)
+        schedule(i, deltaTime);
+
+    // Handle impacts earliest first; each one changes at most two logos, so only those are rescheduled.
+    // The cap stops logos wedged against each other from spinning forever at one instant.
+    unsigned int corners = 0;
+    size_t maxEvents = 16 * count + 16;
+    CollisionQueue::Event event;
+    eventCount = 0;
+    while (eventCount < maxEvents && queue.pop(event) && event.time <= deltaTime) {
+        eventCount++;
+        if (event.b == CollisionQueue::WALL) {
+            corners += bounceWall(event.a, event.axis, event.time);
+            schedule(event.a, deltaTime);
+        } else {
+            advanceTo(event.a, event.time);
+            advanceTo(event.b, event.time);
+            exchangeVelocities(logos[event.a], logos[event.b], event.axis);
+            queue.touch(event.a);
+            queue.touch(event.b);
+            widen(event.a, deltaTime);
+            widen(event.b, deltaTime);
+            schedule(event.a, deltaTime);
+            schedule(event.b, deltaTime);
+        }
+    }
+
+    for (unsigned int i = 0; i < count; i++) {
+        advanceTo(i, deltaTime);
+        reach[i] = 0;
+        x[i] = logos[i].pos.x;
+        y[i] = logos[i].pos.y;
+    }
+    return corners;
+}
+
+void LogoField::advanceTo(unsigned int index, double time) {
+    logos[index].pos += logos[index].velocity * (time - times[index]);
+    times[index] = time;
+}
+
+void LogoField::widen(unsigned int index, double deltaTime) {
+    const Logo &logo = logos[index];
+    double speed = glm::length(logo.velocity);
+
+    // No faster than the broad phase allowed for, so it stays inside the area that was covered
+    if (speed <= speedLimits[index])
+        return;
+
+    // A collision sped it up: find every logo its new path could reach (rare, so a plain scan is fine)
+    double remaining = speed * (deltaTime - times[index]);
+    speedLimits[index] = speed;
+    reach[index] = remaining;
+
+    // Candidate lists are symmetric, so the logos already listed for this one are the pairs to skip
+    visited.resize(logos.size(), 0);
+    if (++visitStamp == 0) {
+        std::fill(visited.begin(), visited.end(), 0);
+        visitStamp = 1;
+    }
+    visited[index] = visitStamp;
+    for (unsigned int other : neighbors[index])
+        visited[other] = visitStamp;
+
+    for (unsigned int other = 0; other < logos.size(); other++) {
+        if (visited[other] == visitStamp)
+            continue;
+        const Logo &b = logos[other];
+        dvec2 delta = b.pos - logo.pos;
+        if (std::fabs(delta.x) < (logo.size.x + b.size.x) / 2 + remaining + reach[other] &&
+            std::fabs(delta.y) < (logo.size.y + b.size.y) / 2 + remaining + reach[other]) {
+            neighbors[index].push_back(other);
+            neighbors[other].push_back(index);
+        }
+    }
+}
+
+void LogoField::schedule(unsigned int index, double deltaTime) {
+    const Logo &logo = logos[index];
+    double now = times[index];
+
+    for (int axis = 0; axis < 2; axis++) {
+        double time = now + timeToWall(logo.pos[axis], logo.velocity[axis], logo.size[axis] / 2,
+                                       bounds[axis] - logo.size[axis] / 2);
+        if (time <= deltaTime)
+            queue.push(time, index, CollisionQueue::WALL, axis);
+    }
+
+    for (unsigned int other : neighbors[index]) {
+        // Bring the other logo's position to the same moment before sweeping
+        const Logo &b = logos[other];
+        dvec2 otherPos = b.pos + b.velocity * (now - times[other]);
+
+        double time;
+        int axis;
+        if (sweepBoxes(logo.pos, logo.velocity, logo.size, otherPos, b.velocity, b.size, deltaTime - now, time, axis))
+            queue.push(now + time, index, other, axis);
+    }
+}
+
+unsigned int LogoField::bounceWall(unsigned int index, int axis, double time) {
+    advanceTo(index, time);
+    Logo &logo = logos[index];
+    queue.touch(index);
+
+    // Same rules as Simulation::advanceExact(): bounce off this wall, and off the other axis's wall as well if
+    // that one is reached within the corner tolerance
+    unsigned int corner = 0;
+    for (int i = 0; i < 2; i++) {
+        int current = i == 0 ? axis : 1 - axis;
+        double low = logo.size[current] / 2, high = bounds[current] - logo.size[current] / 2;
+        if (current != axis && timeToWall(logo.pos[current], logo.velocity[current], low, high) > Simulation::CORNER_TOLERANCE)
+            break;
+
+        logo.pos[current] = logo.velocity[current] > 0 ? high : low;
+        logo.velocity[current] = -logo.velocity[current];
+        wallsHit++;
+        corner = current != axis ? 1 : 0;
+    }
+    cornersHit += corner;
+    return corner;
+}
+
+double LogoField::sweptLeft(unsigned int index) const {
+    return logos[index].pos.x - logos[index].size.x / 2 - reach[index];
+}
+
+void LogoField::sortByLeft() {
+    // Insertion sort: the logos only move a little each tick, so almost every element is already in place
+    for (size_t i = 1; i < order.size(); i++) {
+        unsigned int index = order[i];
+        double left = sweptLeft(index);
+        size_t j = i;
+        while (j > 0 && sweptLeft(order[j - 1]) > left) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = index;
+    }
+}
+
+void LogoField::findPairs() {
+    pairs.clear();
+    for (size_t i = 0; i < order.size(); i++) {
+        const Logo &a = logos[order[i]];
+        double right = a.pos.x + a.size.x / 2 + reach[order[i]];
+
+        // Every logo after this one in the order starts further right, so stop at the first that starts past its right edge
+        for (size_t j = i + 1; j < order.size(); j++) {
+            const Logo &b = logos[order[j]];
+            if (sweptLeft(order[j]) > right)
+                break;
+            if (std::fabs(a.pos.y - b.pos.y) < (a.size.y + b.size.y) / 2 + reach[order[i]] + reach[order[j]])
+                pairs.emplace_back(order[i], order[j]);
+        }
+    }
+}
+
+bool LogoField::isOverlapping(const Logo &a, const Logo &b) {
+    // Check if the distance between the centers is less than half the sum of the sizes on both axes
+    return std::fabs(a.pos.x - b.pos.x) < (a.size.x + b.size.x) / 2 &&
+           std::fabs(a.pos.y - b.pos.y) < (a.size.y + b.size.y) / 2;
+}
+
+void LogoField::bounce(Logo &a, Logo &b) {
+    dvec2 delta = b.pos - a.pos;
+    double overlapX = (a.size.x + b.size.x) / 2 - std::fabs(delta.x);
+    double overlapY = (a.size.y + b.size.y) / 2 - std::fabs(delta.y);
+
+    // Collide along the axis that needs the smaller push to separate them
+    int axis = overlapX < overlapY ? 0 : 1;
+    double overlap = axis == 0 ? overlapX : overlapY;
+    double direction = delta[axis] < 0 ? -1 : 1;
+
+    // Area as a proxy for mass; the lighter logo is pushed further
+    double aMass = a.size.x * a.size.y;
+    double bMass = b.size.x * b.size.y;
+    double totalMass = aMass + bMass;
+    a.pos[axis] -= direction * overlap * (bMass / totalMass);
+    b.pos[axis] += direction * overlap * (aMass / totalMass);
+
+    exchangeVelocities(a, b, axis);
+}
+
+void LogoField::exchangeVelocities(Logo &a, Logo &b, int axis) {
+    double direction = b.pos[axis] - a.pos[axis] < 0 ? -1 : 1;
+    double aMass = a.size.x * a.size.y;
+    double bMass = b.size.x * b.size.y;
+    double totalMass = aMass + bMass;
+
+    // Velocity calculations for elastic collision, only if they are moving towards each other
+    double aVelocity = a.velocity[axis];
+    double bVelocity = b.velocity[axis];
+    double velocityDifference = aVelocity - bVelocity;
+    if (velocityDifference * direction > 0) {
+        a.velocity[axis] = aVelocity - (2 * bMass / totalMass) * velocityDifference;
+        b.velocity[axis] = bVelocity + (2 * aMass / totalMass) * velocityDifference;
+    }
+}
+
+size_t LogoField::size() const               { return logos.size(); }
+const vector<Logo> &LogoField::getLogos() const { return logos; }
+long long LogoField::getWallsHit() const     { return wallsHit; }
+long long LogoField::getCornersHit() const   { return cornersHit; }
+size_t LogoField::getCandidatePairs() const  { return pairs.size(); }
+size_t LogoField::getEventCount() const      { return eventCount; }
+const float *LogoField::getX() const         { return x.data(); }
+const float *LogoField::getY() const         { return y.data(); }
+const float *LogoField::getWidth() const     { return width.data(); }
+const float *LogoField::getHeight() const    { return height.data(); }
+const vec4 *LogoField::getColors() const     { return colors.data(); }
@@ -0,0 +1,138 @@
+#ifndef GRAPHICS_LOGOFIELD_H
+#define GRAPHICS_LOGOFIELD_H
+
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "simulation.h"
+#include "sweep.h"
+
+using std::vector, glm::vec4;
+
+/**
+ * @brief Many bouncing logos that also bounce off each other
+ * @details Every tick each logo is moved and bounced off the walls with Simulation::checkBounds(), so walls and
+ * corners are counted exactly as for the single logo. Logo-vs-logo collisions then use sweep and prune: the logos
+ * are kept sorted by their left edge (an insertion sort, which is nearly linear because the order barely changes
+ * between ticks) and only logos whose x ranges overlap are tested. Overlapping pairs get the same mass-weighted
+ * elastic response as Circle::bounce(), along the axis of least penetration.
+ *
+ * In StepMode::Event the same broad phase runs on each logo's swept bounds instead, and walls and logo-vs-logo
+ * impacts are found with swept tests and processed in time order (see CollisionQueue), so fast logos can't pass
+ * through each other or the walls between ticks.
+ */
+class LogoField {
+    public:
+        /// @brief Construct a new Logo Field object
+        /// @param bounds Width and height of the box the logos bounce in (the window size)
+        /// @param mode Clamp to resolve overlaps after moving, Event for continuous collision detection
+        explicit LogoField(vec2 bounds, StepMode mode = StepMode::Clamp);
+
+        /// @brief Adds a logo
+        void add(const Logo &logo, vec4 color);
+
+        /// @brief Adds count logos with random sizes, positions, velocities and colors
+        /// @param count The number of logos to add
+        /// @param seed Seed for the random generator, so the same seed gives the same field
+        void scatter(size_t count, unsigned int seed);
+
+        /// @brief Advances every logo by one tick and resolves the collisions between them
+        /// @param deltaTime Length of the tick in seconds
+        /// @return The number of corners hit during this tick
+        unsigned int step(float deltaTime);
+
+        // --------------------------------------------------------
+        // Getters
+        // --------------------------------------------------------
+        size_t size() const;
+        const vector<Logo> &getLogos() const;
+        long long getWallsHit() const;
+        long long getCornersHit() const;
+        /// @brief Number of pairs the broad phase passed to the narrow phase during the last step
+        size_t getCandidatePairs() const;
+        /// @brief Number of wall and logo impacts processed during the last step (event mode only)
+        size_t getEventCount() const;
+
+        /// @brief Per-logo columns for ParticleRenderer, refreshed by every step()
+        const float *getX() const;
+        const float *getY() const;
+        const float *getWidth() const;
+        const float *getHeight() const;
+        const vec4 *getColors() const;
+
+    private:
+        /// @brief Width and height of the box
+        vec2 bounds;
+
+        /// @brief How step() moves the logos
+        StepMode mode;
+
+        /// @brief The logos and their colors
+        vector<Logo> logos;
+        vector<vec4> colors;
+
+        /// @brief Logo indices sorted by left edge, kept from one step to the next
+        vector<unsigned int> order;
+
+        /// @brief Candidate pairs found by the broad phase (reused every step)
+        vector<std::pair<unsigned int, unsigned int>> pairs;
+
+        /// @brief How far each logo can move during the current step (0 in clamp mode), added to its bounds in the broad phase
+        vector<double> reach;
+
+        /// @brief Event mode: the candidates of each logo, the time each logo has been advanced to, the speed its candidates
+        /// were found for, and the pending impacts
+        vector<vector<unsigned int>> neighbors;
+        vector<double> times;
+        vector<double> speedLimits;
+        CollisionQueue queue;
+        size_t eventCount = 0;
+
+        /// @brief Event mode: widen() stamps the current candidates of a logo here so it doesn't add them twice
+        vector<unsigned int> visited;
+        unsigned int visitStamp = 0;
+
+        /// @brief Render columns (single precision copies of each logo's position and size)
+        vector<float> x, y, width, height;
+
+        // Keep track of walls and corners
+        long long wallsHit = 0;
+        long long cornersHit = 0;
+
+        /// @brief Moves every logo along its path for deltaTime, handling every impact in time order
+        unsigned int stepExact(float deltaTime);
+
+        /// @brief Event mode: moves a logo forward to time
+        void advanceTo(unsigned int index, double time);
+
+        /// @brief Event mode: adds candidates for a logo that a collision made faster than the broad phase allowed for
+        void widen(unsigned int index, double deltaTime);
+
+        /// @brief Event mode: queues the next wall impacts of a logo and its impacts with its candidates
+        void schedule(unsigned int index, double deltaTime);
+
+        /// @brief Event mode: bounces a logo off the wall it reached on axis, and off the other axis's wall too if that is a corner
+        /// @return 1 if it was a corner, 0 otherwise
+        unsigned int bounceWall(unsigned int index, int axis, double time);
+
+        /// @brief Returns a logo's left edge, less its reach
+        double sweptLeft(unsigned int index) const;
+
+        /// @brief Restores the left-edge order after the logos have moved
+        void sortByLeft();
+
+        /// @brief Sweeps the sorted logos and collects every pair whose bounding boxes overlap
+        void findPairs();
+
+        /// @brief Checks if two logos are overlapping
+        static bool isOverlapping(const Logo &a, const Logo &b);
+
+        /// @brief Separates two overlapping logos and exchanges their velocities along the collision axis
+        static void bounce(Logo &a, Logo &b);
+
+        /// @brief Elastic collision along one axis (area as mass), if the logos are moving towards each other
+        static void exchangeVelocities(Logo &a, Logo &b, int axis);
+};
+
+#endif //GRAPHICS_LOGOFIELD_H
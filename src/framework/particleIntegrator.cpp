@@ -0,0 +1,149 @@
+#include "particleIntegrator.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PARTICLE_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang only emit AVX2 instructions inside functions marked with the avx2 target,
+// which lets the rest of the project keep building for the baseline instruction set.
+#if defined(PARTICLE_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PARTICLE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PARTICLE_TARGET_AVX2
+#endif
+
+void integrateParticlesScalar(const ParticleArrays &p, size_t begin, size_t end, float deltaTime, float gravity) {
+    for (size_t i = begin; i < end; i++) {
+        // Update the position of each particle
+        p.x[i] += p.velocityX[i] * deltaTime;
+        p.y[i] += p.velocityY[i] * deltaTime;
+
+        // Make the velocity decrease to simulate gravity
+        p.velocityY[i] -= gravity;
+
+        // Determine if the particle is still on the screen
+        p.alive[i] = p.y[i] + (p.height[i] / 2) >= 0;
+    }
+}
+
+#ifdef PARTICLE_X86
+
+void integrateParticlesSSE(const ParticleArrays &p, size_t begin, size_t end, float deltaTime, float gravity) {
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 g = _mm_set1_ps(gravity);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 zero = _mm_setzero_ps();
+
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 x = _mm_loadu_ps(p.x + i);
+        __m128 y = _mm_loadu_ps(p.y + i);
+        __m128 vx = _mm_loadu_ps(p.velocityX + i);
+        __m128 vy = _mm_loadu_ps(p.velocityY + i);
+
+        // Separate multiply and add (no FMA) so every kernel rounds exactly like the scalar one
+        x = _mm_add_ps(x, _mm_mul_ps(vx, dt));
+        y = _mm_add_ps(y, _mm_mul_ps(vy, dt));
+        vy = _mm_sub_ps(vy, g);
+
+        _mm_storeu_ps(p.x + i, x);
+        _mm_storeu_ps(p.y + i, y);
+        _mm_storeu_ps(p.velocityY + i, vy);
+
+        __m128 top = _mm_add_ps(y, _mm_mul_ps(_mm_loadu_ps(p.height + i), half));
+        int mask = _mm_movemask_ps(_mm_cmpge_ps(top, zero));
+        for (int lane = 0; lane < 4; lane++)
+            p.alive[i + lane] = (mask >> lane) & 1;
+    }
+
+    // Leftover particles that don't fill a whole register
+    integrateParticlesScalar(p, i, end, deltaTime, gravity);
+}
+
+PARTICLE_TARGET_AVX2
+void integrateParticlesAVX2(const ParticleArrays &p, size_t begin, size_t end, float deltaTime, float gravity) {
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    const __m256 g = _mm256_set1_ps(gravity);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 x = _mm256_loadu_ps(p.x + i);
+        __m256 y = _mm256_loadu_ps(p.y + i);
+        __m256 vx = _mm256_loadu_ps(p.velocityX + i);
+        __m256 vy = _mm256_loadu_ps(p.velocityY + i);
+
+        x = _mm256_add_ps(x, _mm256_mul_ps(vx, dt));
+        y = _mm256_add_ps(y, _mm256_mul_ps(vy, dt));
+        vy = _mm256_sub_ps(vy, g);
+
+        _mm256_storeu_ps(p.x + i, x);
+        _mm256_storeu_ps(p.y + i, y);
+        _mm256_storeu_ps(p.velocityY + i, vy);
+
+        __m256 top = _mm256_add_ps(y, _mm256_mul_ps(_mm256_loadu_ps(p.height + i), half));
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(top, zero, _CMP_GE_OQ));
+        for (int lane = 0; lane < 8; lane++)
+            p.alive[i + lane] = (mask >> lane) & 1;
+    }
+
+    integrateParticlesSSE(p, i, end, deltaTime, gravity);
+}
+
+/// @brief Returns true if the CPU and operating system both support AVX2.
+static bool cpuSupportsAVX2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#else
+
+void integrateParticlesSSE(const ParticleArrays &p, size_t begin, size_t end, float deltaTime, float gravity) {
+    integrateParticlesScalar(p, begin, end, deltaTime, gravity);
+}
+
+void integrateParticlesAVX2(const ParticleArrays &p, size_t begin, size_t end, float deltaTime, float gravity) {
+    integrateParticlesScalar(p, begin, end, deltaTime, gravity);
+}
+
+static bool cpuSupportsAVX2() { return false; }
+
+#endif
+
+ParticleKernel getParticleKernel() {
+    static const ParticleKernel kernel = cpuSupportsAVX2() ? integrateParticlesAVX2
+#ifdef PARTICLE_X86
+                                                           : integrateParticlesSSE;
+#else
+                                                           : integrateParticlesScalar;
+#endif
+    return kernel;
+}
+
+const char *getParticleKernelName() {
+    ParticleKernel kernel = getParticleKernel();
+    if (kernel == integrateParticlesAVX2)
+        return "avx2";
+    if (kernel == integrateParticlesSSE)
+        return "sse";
+    return "scalar";
+}
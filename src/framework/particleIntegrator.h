@@ -0,0 +1,43 @@
+#ifndef GRAPHICS_PARTICLEINTEGRATOR_H
+#define GRAPHICS_PARTICLEINTEGRATOR_H
+
+#include <cstddef>
+
+/// @brief Particle arrays handed to the integration kernels (structure of arrays, one value per particle).
+struct ParticleArrays {
+    float *x;
+    float *y;
+    float *velocityX;
+    float *velocityY;
+    const float *height;
+    /// @brief Set to 1 if the particle is still on screen after the step, 0 otherwise
+    unsigned char *alive;
+};
+
+/// @brief Signature shared by every integration kernel.
+/// @details Steps particles [begin, end): position += velocity * deltaTime, then velocity.y -= gravity,
+/// then marks whether the top of each particle is still above the bottom of the screen.
+typedef void (*ParticleKernel)(const ParticleArrays &particles, size_t begin, size_t end,
+                               float deltaTime, float gravity);
+
+/// @brief Steps particles one at a time. Always available.
+void integrateParticlesScalar(const ParticleArrays &particles, size_t begin, size_t end,
+                              float deltaTime, float gravity);
+
+/// @brief Steps particles 4 at a time with SSE2 (scalar fallback on non-x86 CPUs).
+void integrateParticlesSSE(const ParticleArrays &particles, size_t begin, size_t end,
+                           float deltaTime, float gravity);
+
+/// @brief Steps particles 8 at a time with AVX2.
+/// @note Only call this if the CPU supports AVX2 (see getParticleKernel()).
+void integrateParticlesAVX2(const ParticleArrays &particles, size_t begin, size_t end,
+                            float deltaTime, float gravity);
+
+/// @brief Returns the widest kernel the running CPU supports.
+/// @details The CPU is queried once; later calls return the cached choice.
+ParticleKernel getParticleKernel();
+
+/// @brief Returns the name of the kernel picked by getParticleKernel() ("avx2", "sse" or "scalar").
+const char *getParticleKernelName();
+
+#endif //GRAPHICS_PARTICLEINTEGRATOR_H
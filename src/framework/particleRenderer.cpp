@@ -0,0 +1,103 @@
+#include "particleRenderer.h"
+#include "profiler.h"
+
+#include <cstring>
+
+ParticleRenderer::ParticleRenderer(Shader& shader) {
+    this->shader = shader;
+    this->initRenderData();
+}
+
+ParticleRenderer::~ParticleRenderer() {
+    // The quad's VBO and EBO belong to the GeometryCache
+    glDeleteVertexArrays(1, &this->VAO);
+}
+
+void ParticleRenderer::initRenderData() {
+    // Reuse the unit quad every Rect draws with; this VAO only adds the instance attributes
+    const Geometry &quad = GeometryCache::get(ShapeType::Rect, 0, Rect::initVectors);
+    indexCount = quad.indexCount;
+
+    glGenVertexArrays(1, &this->VAO);
+
+    glBindVertexArray(this->VAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, quad.VBO);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quad.EBO);
+
+    // Per-instance attributes (1 = x, 2 = y, 3 = width, 4 = height, 5 = color) advance once per instance;
+    // they are pointed at the instance buffer by render(), since every frame's data lands somewhere else
+    for (GLuint attribute = 1; attribute <= 5; attribute++) {
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribDivisor(attribute, 1);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0); // Don't unbind EBO before the VAO because it's bound to VAO
+}
+
+void ParticleRenderer::initInstanceAttributes(size_t offset, unsigned int count) {
+    size_t column = count * sizeof(float);
+    glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(offset));
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(offset + column));
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(offset + 2 * column));
+    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(offset + 3 * column));
+    glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(glm::vec4), (void*)(offset + 4 * column));
+}
+
+void ParticleRenderer::reserve(unsigned int capacity) {
+    if (capacity <= this->capacity)
+        return;
+
+    this->capacity = capacity;
+    instances = std::make_unique<StreamBuffer>(GL_ARRAY_BUFFER, StreamBuffer::FRAMES_IN_FLIGHT * capacity * INSTANCE_SIZE);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void ParticleRenderer::render(const float *x, const float *y, const float *width, const float *height,
+                              const glm::vec4 *colors, unsigned int count) {
+    if (count == 0)
+        return;
+
+    // Grow the instance buffer (doubling) when there are more particles than it can hold
+    if (count > capacity) {
+        unsigned int newCapacity = capacity == 0 ? count : capacity;
+        while (newCapacity < count)
+            newCapacity *= 2;
+        this->reserve(newCapacity);
+    }
+
+    // Write each column of particle data into this frame's region of the ring (16-byte aligned for the colors)
+    size_t column = count * sizeof(float);
+    size_t offset;
+    char *region = static_cast<char*>(instances->map(count * INSTANCE_SIZE, sizeof(glm::vec4), offset));
+    if (!region)
+        return;
+    std::memcpy(region, x, column);
+    std::memcpy(region + column, y, column);
+    std::memcpy(region + 2 * column, width, column);
+    std::memcpy(region + 3 * column, height, column);
+    std::memcpy(region + 4 * column, colors, count * sizeof(glm::vec4));
+    instances->unmap();
+
+    glBindVertexArray(this->VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, instances->getBuffer());
+    this->initInstanceAttributes(offset, count);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // One draw call for every particle
+    this->shader.use();
+    glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0, count);
+    Profiler::countDrawCall();
+    instances->fence();
+    glBindVertexArray(0);
+}
+
+void ParticleRenderer::render(const ParticleSystem& particles) {
+    // The particle system already stores its data as columns, so it can be uploaded as-is
+    this->render(particles.getX(), particles.getY(), particles.getWidth(),
+                 particles.getHeight(), particles.getColors(), particles.size());
+}
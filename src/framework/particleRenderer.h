@@ -0,0 +1,114 @@
+#ifndef GRAPHICS_PARTICLERENDERER_H
+#define GRAPHICS_PARTICLERENDERER_H
+
+#include <memory>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "shader.h"
+#include "particleSystem.h"
+#include "streamBuffer.h"
+#include "../shapes/rect.h"
+
+/**
+ * @brief An instanced particle renderer
+ * @details This class draws any number of colored quads with a single instanced draw call.
+ * Every particle shares the unit quad from the GeometryCache; its position, size and color are streamed
+ * into a StreamBuffer once per frame, so each frame writes a fresh region instead of overwriting the one
+ * the GPU may still be drawing from.
+ */
+class ParticleRenderer {
+    public:
+        /**
+         * @brief Construct a new Particle Renderer object
+         * @details This constructor will initialize the unit quad and the instance buffer
+         *
+         * @param shader The instanced shader to use (particle.vert/particle.frag)
+         */
+        ParticleRenderer(Shader& shader);
+
+        /**
+         * @brief Destroy the Particle Renderer object
+         * @details destroys the VAO and instance buffer associated with the renderer
+         */
+        ~ParticleRenderer();
+
+        /**
+         * @brief Allocates room for at least capacity particles per frame in the instance buffer
+         * @details Call this at startup with the particle pool's capacity so no frame has to grow the buffer.
+         * The ring holds StreamBuffer::FRAMES_IN_FLIGHT frames of that many particles.
+         *
+         * @param capacity The number of particles to make room for
+         */
+        void reserve(unsigned int capacity);
+
+        /**
+         * @brief Renders every particle in one glDrawElementsInstanced call
+         * @details Each array holds one value per particle (structure of arrays).
+         *
+         * @param x The x position of each particle
+         * @param y The y position of each particle
+         * @param width The width of each particle
+         * @param height The height of each particle
+         * @param colors The color of each particle
+         * @param count The number of particles
+         */
+        void render(const float *x, const float *y, const float *width, const float *height,
+                    const glm::vec4 *colors, unsigned int count);
+
+        /**
+         * @brief Renders every particle in a particle system
+         *
+         * @param particles The particle system to render
+         */
+        void render(const ParticleSystem& particles);
+
+    private:
+        /**
+         * @brief The shader to use
+         */
+        Shader shader;
+
+        /**
+         * @brief The VAO binding the cached unit quad together with the per-instance attributes
+         */
+        GLuint VAO;
+
+        /**
+         * @brief The ring buffer each frame's instance data is written into
+         */
+        std::unique_ptr<StreamBuffer> instances;
+
+        /**
+         * @brief The number of indices in the unit quad
+         */
+        unsigned int indexCount = 0;
+
+        /**
+         * @brief The number of particles per frame the instance buffer currently has room for
+         */
+        unsigned int capacity = 0;
+
+        /**
+         * @brief Bytes of instance data per particle: x, y, width, height and color
+         */
+        static const size_t INSTANCE_SIZE = 4 * sizeof(float) + sizeof(glm::vec4);
+
+        /**
+         * @brief Initializes the unit quad and configures the vertex attributes
+         */
+        void initRenderData();
+
+        /**
+         * @brief Points the per-instance attributes at this frame's region of the instance buffer
+         * @details Each frame's region is laid out as [x | y | width | height | colors],
+         * so the offsets depend on where the region starts and on the particle count.
+         * Assumes the VAO and instance buffer are bound.
+         *
+         * @param offset Byte offset of the region in the instance buffer
+         * @param count The number of particles in the region
+         */
+        void initInstanceAttributes(size_t offset, unsigned int count);
+};
+
+#endif //GRAPHICS_PARTICLERENDERER_H
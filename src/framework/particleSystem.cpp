@@ -0,0 +1,80 @@
+#include "particleSystem.h"
+#include "particleIntegrator.h"
+
+ParticleSystem::ParticleSystem(size_t capacity) :
+    x(capacity), y(capacity), velocityX(capacity), velocityY(capacity),
+    width(capacity), height(capacity), colors(capacity), alive(capacity) {}
+
+bool ParticleSystem::spawn(vec2 pos, vec2 velocity, vec2 size, vec4 color) {
+    if (full())
+        return false;
+
+    x[count] = pos.x;
+    y[count] = pos.y;
+    velocityX[count] = velocity.x;
+    velocityY[count] = velocity.y;
+    width[count] = size.x;
+    height[count] = size.y;
+    colors[count] = color;
+    count++;
+    return true;
+}
+
+void ParticleSystem::remove(size_t index) {
+    // Move the last live particle into the removed particle's slot, then free the last slot
+    size_t last = count - 1;
+    x[index] = x[last];
+    y[index] = y[last];
+    velocityX[index] = velocityX[last];
+    velocityY[index] = velocityY[last];
+    width[index] = width[last];
+    height[index] = height[last];
+    colors[index] = colors[last];
+    count--;
+}
+
+void ParticleSystem::clear() {
+    count = 0;
+}
+
+void ParticleSystem::update(float deltaTime, float gravity, JobSystem *jobs) {
+    ParticleArrays arrays = {x.data(), y.data(), velocityX.data(), velocityY.data(), height.data(), alive.data()};
+    ParticleKernel kernel = getParticleKernel();
+
+    if (jobs != nullptr && count > CHUNK_SIZE) {
+        jobs->parallelFor(count, CHUNK_SIZE, [&](size_t begin, size_t end) {
+            kernel(arrays, begin, end, deltaTime, gravity);
+        });
+    } else {
+        kernel(arrays, 0, count, deltaTime, gravity);
+    }
+
+    // Velocity only ever decreases, so once the top of a particle is below the screen it never comes back
+    removeDead();
+}
+
+void ParticleSystem::removeDead() {
+    size_t i = 0;
+    while (i < count) {
+        if (alive[i]) {
+            i++;
+        } else {
+            // The last particle now sits at i, so carry its flag along and check it before moving on
+            alive[i] = alive[count - 1];
+            remove(i);
+        }
+    }
+}
+
+size_t ParticleSystem::size() const        { return count; }
+bool ParticleSystem::empty() const         { return count == 0; }
+bool ParticleSystem::full() const          { return count == x.size(); }
+size_t ParticleSystem::getCapacity() const { return x.size(); }
+
+const float *ParticleSystem::getX() const         { return x.data(); }
+const float *ParticleSystem::getY() const         { return y.data(); }
+const float *ParticleSystem::getVelocityX() const { return velocityX.data(); }
+const float *ParticleSystem::getVelocityY() const { return velocityY.data(); }
+const float *ParticleSystem::getWidth() const     { return width.data(); }
+const float *ParticleSystem::getHeight() const    { return height.data(); }
+const vec4 *ParticleSystem::getColors() const     { return colors.data(); }
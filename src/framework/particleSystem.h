@@ -0,0 +1,100 @@
+#ifndef GRAPHICS_PARTICLESYSTEM_H
+#define GRAPHICS_PARTICLESYSTEM_H
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "jobSystem.h"
+
+using std::vector, glm::vec2, glm::vec4;
+
+/**
+ * @brief A fixed-capacity structure-of-arrays particle pool
+ * @details Every particle attribute lives in its own contiguous array, so a particle is just an index.
+ * All arrays are allocated once, at construction, to hold `capacity` particles. Spawning claims the
+ * next free slot and removal swaps the last live particle into the freed slot (swap-and-pop), so the
+ * live particles always occupy slots [0, size()) and spawning never allocates.
+ */
+class ParticleSystem {
+    public:
+        /// @brief Construct an empty Particle System object
+        /// @details Preallocates every array so spawning never allocates.
+        /// @param capacity The maximum number of live particles
+        explicit ParticleSystem(size_t capacity);
+
+        /// @brief Claims the next free slot for a new particle
+        /// @return false (and spawns nothing) if the pool is full
+        /// @param pos The position of the particle's center
+        /// @param velocity The x and y velocities of the particle
+        /// @param size The width and height of the particle
+        /// @param color The color of the particle
+        bool spawn(vec2 pos, vec2 velocity, vec2 size, vec4 color);
+
+        /// @brief Removes a particle by moving the last particle into its slot
+        /// @note This changes the order of the particles
+        /// @param index The index of the particle to remove
+        void remove(size_t index);
+
+        /// @brief Removes every particle
+        /// @details The slots are kept for reuse.
+        void clear();
+
+        /// @brief Moves every particle and removes the ones that have fallen below the screen
+        /// @details Uses the widest SIMD kernel the CPU supports (see particleIntegrator.h).
+        /// @details Large systems are integrated in chunks across the job system's threads. Each chunk
+        /// only flags its own particles, and dead particles are removed afterwards on the calling thread
+        /// in index order, so the result is the same no matter how many threads took part.
+        /// @param deltaTime Time since the last update
+        /// @param gravity Amount subtracted from each particle's y velocity per update
+        /// @param jobs Job system to spread the work across (nullptr to run on the calling thread)
+        void update(float deltaTime, float gravity, JobSystem *jobs = nullptr);
+
+        /// @brief Particles per job when updating on the job system
+        /// @details Big enough that a chunk outweighs the cost of handing it to another thread,
+        /// and a multiple of 8 so the AVX2 kernel never runs its scalar tail inside a chunk.
+        static const size_t CHUNK_SIZE = 8192;
+
+        // --------------------------------------------------------
+        // Getters
+        // --------------------------------------------------------
+        /// @brief Returns the number of live particles
+        size_t size() const;
+        bool empty() const;
+        bool full() const;
+
+        /// @brief Returns the maximum number of live particles
+        size_t getCapacity() const;
+
+        // Each array holds size() live particles
+        const float *getX() const;
+        const float *getY() const;
+        const float *getVelocityX() const;
+        const float *getVelocityY() const;
+        const float *getWidth() const;
+        const float *getHeight() const;
+        const vec4 *getColors() const;
+
+    private:
+        /// @brief The number of live particles
+        size_t count = 0;
+
+        /// @brief The position of each particle's center
+        vector<float> x, y;
+
+        /// @brief The x and y velocities of each particle
+        vector<float> velocityX, velocityY;
+
+        /// @brief The width and height of each particle
+        vector<float> width, height;
+
+        /// @brief The color of each particle
+        vector<vec4> colors;
+
+        /// @brief Scratch array the integration kernel fills with 1 for particles still on screen
+        vector<unsigned char> alive;
+
+        /// @brief Removes every particle whose alive flag is 0 (swap-and-pop)
+        void removeDead();
+};
+
+#endif //GRAPHICS_PARTICLESYSTEM_H
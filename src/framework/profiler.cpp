@@ -0,0 +1,133 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+
+unsigned int Profiler::drawCalls = 0;
+unsigned int Profiler::uniformUploads = 0;
+
+Profiler::~Profiler() {
+    if (gpuTimers)
+        glDeleteQueries(PHASE_COUNT * QUERY_LATENCY, &queries[0][0]);
+}
+
+void Profiler::initGpuTimers() {
+    if (gpuTimers)
+        return;
+    glGenQueries(PHASE_COUNT * QUERY_LATENCY, &queries[0][0]);
+    gpuTimers = true;
+}
+
+void Profiler::beginFrame() {
+    Clock::time_point now = Clock::now();
+    if (started)
+        frameHistory.add(std::chrono::duration<float, std::milli>(now - frameStart).count());
+    frameStart = now;
+    started = true;
+
+    frame++;
+    if (gpuTimers)
+        collectQueries(frame % QUERY_LATENCY);
+
+    lastDrawCalls = drawCalls;
+    lastUniformUploads = uniformUploads;
+    lastParticleCount = particleCount;
+    drawCalls = 0;
+    uniformUploads = 0;
+    particleCount = 0;
+}
+
+void Profiler::collectQueries(unsigned int slot) {
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+        if (!pending[phase][slot])
+            continue;
+        pending[phase][slot] = false;
+
+        // Asking for a result that isn't ready would block; after QUERY_LATENCY frames it almost always is,
+        // and a sample that isn't is dropped
+        GLint available = 0;
+        glGetQueryObjectiv(queries[phase][slot], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            continue;
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(queries[phase][slot], GL_QUERY_RESULT, &nanoseconds);
+        gpuHistory[phase].add(float(nanoseconds / 1e6));
+    }
+}
+
+void Profiler::begin(Phase phase) {
+    phaseStart[phase] = Clock::now();
+    if (gpuTimers)
+        glBeginQuery(GL_TIME_ELAPSED, queries[phase][frame % QUERY_LATENCY]);
+}
+
+void Profiler::end(Phase phase) {
+    if (gpuTimers) {
+        glEndQuery(GL_TIME_ELAPSED);
+        pending[phase][frame % QUERY_LATENCY] = true;
+    }
+    cpuHistory[phase].add(std::chrono::duration<float, std::milli>(Clock::now() - phaseStart[phase]).count());
+}
+
+void Profiler::setParticleCount(size_t count) {
+    particleCount = count;
+}
+
+void Profiler::report(std::ostream &out) const {
+    char line[128];
+    Stats stats = getFrameStats();
+    std::snprintf(line, sizeof(line), "%-8s min %6.2f  avg %6.2f  p99 %6.2f ms", "Frame", stats.min, stats.avg, stats.p99);
+    out << line << "\n";
+
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+        Stats cpu = getCpuStats(Phase(phase));
+        Stats gpu = getGpuStats(Phase(phase));
+        std::snprintf(line, sizeof(line), "%-8s cpu avg %6.2f  p99 %6.2f | gpu avg %6.2f  p99 %6.2f ms",
+                      getName(Phase(phase)), cpu.avg, cpu.p99, gpu.avg, gpu.p99);
+        out << line << "\n";
+    }
+
+    std::snprintf(line, sizeof(line), "Draws %u  Uniforms %u  Particles %zu", lastDrawCalls, lastUniformUploads,
+                  lastParticleCount);
+    out << line << "\n";
+}
+
+void Profiler::History::add(float milliseconds) {
+    samples[next] = milliseconds;
+    next = (next + 1) % HISTORY;
+    if (count < HISTORY)
+        count++;
+}
+
+Profiler::Stats Profiler::History::getStats() const {
+    Stats stats;
+    if (count == 0)
+        return stats;
+
+    // The newest sample is the one before next; the oldest ones start at next once the ring is full
+    stats.last = samples[(next + HISTORY - 1) % HISTORY];
+    float sorted[HISTORY];
+    std::copy(samples, samples + count, sorted);
+    std::sort(sorted, sorted + count);
+
+    float total = 0;
+    for (size_t i = 0; i < count; i++)
+        total += sorted[i];
+    stats.min = sorted[0];
+    stats.avg = total / count;
+    stats.p99 = sorted[(count * 99 + 99) / 100 - 1];
+    return stats;
+}
+
+Profiler::Stats Profiler::getFrameStats() const           { return frameHistory.getStats(); }
+Profiler::Stats Profiler::getCpuStats(Phase phase) const  { return cpuHistory[phase].getStats(); }
+Profiler::Stats Profiler::getGpuStats(Phase phase) const  { return gpuHistory[phase].getStats(); }
+bool Profiler::hasGpuTimers() const                       { return gpuTimers; }
+unsigned int Profiler::getDrawCalls() const               { return lastDrawCalls; }
+unsigned int Profiler::getUniformUploads() const          { return lastUniformUploads; }
+size_t Profiler::getParticleCount() const                 { return lastParticleCount; }
+
+const char *Profiler::getName(Phase phase) {
+    static const char *names[PHASE_COUNT] = {"Input", "Update", "Render", "Present"};
+    return names[phase];
+}
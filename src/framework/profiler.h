@@ -0,0 +1,138 @@
+#ifndef GRAPHICS_PROFILER_H
+#define GRAPHICS_PROFILER_H
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <glad/glad.h>
+
+/**
+ * @brief Frame-time profiler for the engine's main loop
+ * @details Each phase of a frame (input, update, render, present) is timed on the CPU with a steady clock and, once
+ * initGpuTimers() has been called with a context current, on the GPU with GL_TIME_ELAPSED queries. Query results are
+ * read QUERY_LATENCY frames later so reading them never stalls the pipeline. The last HISTORY samples of every timer
+ * are kept, and getStats() summarises them as min/avg/p99.
+ *
+ * Draw calls and uniform uploads are counted through the static countDrawCall() / countUniformUpload() hooks, which
+ * the draw and upload sites call directly so no renderer has to know about the engine's profiler.
+ */
+class Profiler {
+    public:
+        /// @brief The parts of a frame, in the order the main loop runs them
+        enum Phase { Input, Update, Render, Present, PHASE_COUNT };
+
+        /// @brief Frames kept for the rolling statistics (4 seconds at 60 fps)
+        static const size_t HISTORY = 240;
+
+        /// @brief Frames a GPU query is given before its result is read
+        static const unsigned int QUERY_LATENCY = 3;
+
+        /// @brief Summary of a timer's history, in milliseconds
+        struct Stats {
+            float last = 0, min = 0, avg = 0, p99 = 0;
+        };
+
+        Profiler() = default;
+
+        /// @brief Destroy the Profiler object
+        /// @details Deletes the GPU queries, if any
+        ~Profiler();
+
+        Profiler(const Profiler &) = delete;
+        Profiler &operator=(const Profiler &) = delete;
+
+        /// @brief Creates the GL_TIME_ELAPSED queries (needs a current context; without one only CPU time is measured)
+        void initGpuTimers();
+
+        /// @brief Ends the previous frame and starts the next one
+        /// @details Records the frame time, collects the GPU results that are ready and latches the counters.
+        void beginFrame();
+
+        /// @brief Starts timing a phase
+        /// @note Phases can't overlap, since only one GL_TIME_ELAPSED query can be active at a time.
+        void begin(Phase phase);
+
+        /// @brief Stops timing a phase
+        void end(Phase phase);
+
+        /// @brief Counts one draw call in the current frame
+        static void countDrawCall() { drawCalls++; }
+
+        /// @brief Counts one uniform (or uniform block) upload in the current frame
+        static void countUniformUpload() { uniformUploads++; }
+
+        /// @brief Sets the number of particles drawn in the current frame
+        void setParticleCount(size_t count);
+
+        /// @brief Writes the statistics of every timer and the counters as text, one line each
+        void report(std::ostream &out) const;
+
+        // --------------------------------------------------------
+        // Getters
+        // --------------------------------------------------------
+        /// @brief Time between the starts of consecutive frames
+        Stats getFrameStats() const;
+        Stats getCpuStats(Phase phase) const;
+        /// @brief All zero until initGpuTimers() has been called
+        Stats getGpuStats(Phase phase) const;
+        bool hasGpuTimers() const;
+        /// @brief Counters of the last complete frame
+        unsigned int getDrawCalls() const;
+        unsigned int getUniformUploads() const;
+        size_t getParticleCount() const;
+        static const char *getName(Phase phase);
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        /// @brief The last HISTORY samples of one timer
+        class History {
+            public:
+                void add(float milliseconds);
+                Stats getStats() const;
+
+            private:
+                float samples[HISTORY] = {};
+                size_t count = 0, next = 0;
+        };
+
+        History frameHistory;
+        History cpuHistory[PHASE_COUNT];
+        History gpuHistory[PHASE_COUNT];
+
+        Clock::time_point frameStart;
+        Clock::time_point phaseStart[PHASE_COUNT];
+        bool started = false;
+
+        /// @brief One ring of queries per phase; pending marks the ones still waiting for their result
+        GLuint queries[PHASE_COUNT][QUERY_LATENCY] = {};
+        bool pending[PHASE_COUNT][QUERY_LATENCY] = {};
+        bool gpuTimers = false;
+        unsigned int frame = 0;
+
+        /// @brief Counters of the frame in progress, and of the last complete frame
+        static unsigned int drawCalls, uniformUploads;
+        unsigned int lastDrawCalls = 0, lastUniformUploads = 0;
+        size_t particleCount = 0, lastParticleCount = 0;
+
+        /// @brief Reads the query results of the slot about to be reused
+        void collectQueries(unsigned int slot);
+};
+
+/**
+ * @brief Times a phase for as long as it is in scope
+ */
+class ProfileScope {
+    public:
+        ProfileScope(Profiler &profiler, Profiler::Phase phase) : profiler(profiler), phase(phase) { profiler.begin(phase); }
+        ~ProfileScope() { profiler.end(phase); }
+
+        ProfileScope(const ProfileScope &) = delete;
+        ProfileScope &operator=(const ProfileScope &) = delete;
+
+    private:
+        Profiler &profiler;
+        Profiler::Phase phase;
+};
+
+#endif //GRAPHICS_PROFILER_H
@@ -1,4 +1,5 @@
 #include "shader.h"
+#include "profiler.h"
 
 Shader &Shader::use() {
     glUseProgram(this->ID);
@@ -37,6 +38,7 @@ void Shader::compile(const char* vertexSource, const char* fragmentSource, const
 
     glLinkProgram(this->ID);
     checkCompileErrors(this->ID, "PROGRAM");
+    cacheUniformLocations();
 
     // delete the shaders as they're linked into our program now and no longer necessary
     glDeleteShader(sVertex);
@@ -45,41 +47,113 @@ void Shader::compile(const char* vertexSource, const char* fragmentSource, const
         glDeleteShader(gShader);
 }
 
+void Shader::cacheUniformLocations() {
+    uniformLocations.clear();
+
+    int count = 0, maxLength = 0;
+    glGetProgramiv(this->ID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(this->ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::string name(maxLength, '\0');
+    for (int i = 0; i < count; i++) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(this->ID, i, maxLength, &length, &size, &type, &name[0]);
+        std::string uniform = name.substr(0, length);
+
+        // Uniforms inside a uniform block don't have a location
+        GLint location = glGetUniformLocation(this->ID, uniform.c_str());
+        if (location == -1)
+            continue;
+        uniformLocations[uniform] = location;
+
+        // Arrays are reported as "name[0]"; also make them reachable by their plain name
+        size_t bracket = uniform.find('[');
+        if (bracket != std::string::npos)
+            uniformLocations[uniform.substr(0, bracket)] = location;
+    }
+}
+
+GLint Shader::getUniformLocation(const char *name) const {
+    auto iter = uniformLocations.find(name);
+    return iter != uniformLocations.end() ? iter->second : -1;
+}
+
 void Shader::setFloat(const char *name, float value) const {
-    glUniform1f(glGetUniformLocation(this->ID, name), value);
+    glUniform1f(getUniformLocation(name), value);
+    Profiler::countUniformUpload();
 }
 
 void Shader::setInteger(const char *name, int value) const {
-    glUniform1i(glGetUniformLocation(this->ID, name), value);
+    glUniform1i(getUniformLocation(name), value);
+    Profiler::countUniformUpload();
 
 }
 
 void Shader::setVector2f(const char *name, float x, float y) const {
-    glUniform2f(glGetUniformLocation(this->ID, name), x, y);
+    glUniform2f(getUniformLocation(name), x, y);
+    Profiler::countUniformUpload();
 }
 
 void Shader::setVector2f(const char *name, const glm::vec2 &value) const {
-    glUniform2f(glGetUniformLocation(this->ID, name), value.x, value.y);
+    glUniform2f(getUniformLocation(name), value.x, value.y);
+    Profiler::countUniformUpload();
 }
 
 void Shader::setVector3f(const char *name, float x, float y, float z) const {
-    glUniform3f(glGetUniformLocation(this->ID, name), x, y, z);
+    glUniform3f(getUniformLocation(name), x, y, z);
+    Profiler::countUniformUpload();
 }
 
 void Shader::setVector3f(const char *name, const glm::vec3 &value) const {
-    glUniform3f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z);
+    glUniform3f(getUniformLocation(name), value.x, value.y, value.z);
+    Profiler::countUniformUpload();
 }
 
 void Shader::setVector4f(const char *name, float x, float y, float z, float w) const {
-    glUniform4f(glGetUniformLocation(this->ID, name), x, y, z, w);
+    glUniform4f(getUniformLocation(name), x, y, z, w);
+    Profiler::countUniformUpload();
 }
 
 void Shader::setVector4f(const char *name, const glm::vec4 &value) const {
-    glUniform4f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z, value.w);
+    glUniform4f(getUniformLocation(name), value.x, value.y, value.z, value.w);
+    Profiler::countUniformUpload();
 }
 
 void Shader::setMatrix4(const char *name, const glm::mat4 &matrix) const {
-    glUniformMatrix4fv(glGetUniformLocation(this->ID, name), 1, false, glm::value_ptr(matrix));
+    glUniformMatrix4fv(getUniformLocation(name), 1, false, glm::value_ptr(matrix));
+    Profiler::countUniformUpload();
+}
+
+void Shader::setFloat(GLint location, float value) const {
+    glUniform1f(location, value);
+    Profiler::countUniformUpload();
+}
+
+void Shader::setInteger(GLint location, int value) const {
+    glUniform1i(location, value);
+    Profiler::countUniformUpload();
+}
+
+void Shader::setVector2f(GLint location, const glm::vec2 &value) const {
+    glUniform2f(location, value.x, value.y);
+    Profiler::countUniformUpload();
+}
+
+void Shader::setVector3f(GLint location, const glm::vec3 &value) const {
+    glUniform3f(location, value.x, value.y, value.z);
+    Profiler::countUniformUpload();
+}
+
+void Shader::setVector4f(GLint location, const glm::vec4 &value) const {
+    glUniform4f(location, value.x, value.y, value.z, value.w);
+    Profiler::countUniformUpload();
+}
+
+void Shader::setMatrix4(GLint location, const glm::mat4 &matrix) const {
+    glUniformMatrix4fv(location, 1, false, glm::value_ptr(matrix));
+    Profiler::countUniformUpload();
 }
 
 
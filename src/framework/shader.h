@@ -1,6 +1,7 @@
 #ifndef SHADER_H
 #define SHADER_H
 
+#include <map>
 #include <string>
 
 #include <glad/glad.h>
@@ -31,8 +32,15 @@ class Shader {
         /// @param geometrySource the source code for the geometry shader (optional)
         void compile(const char *vertexSource, const char *fragmentSource, const char *geometrySource = nullptr); // note: geometry source code is optional
 
+        /// @brief Returns the location of a uniform from the cache built at link time
+        /// @details No OpenGL call is made; the location can be passed to the location-based setters below.
+        /// @param name name of the uniform
+        /// @return the uniform's location, or -1 if the program has no active uniform with that name
+        GLint getUniformLocation(const char *name) const;
+
         // ------------------------------------------------------------------------
         // utility functions
+        // The name-based setters look up the cached location, so they never ask the driver by string.
         // ------------------------------------------------------------------------
 
         /// @brief set a uniform float in the shader
@@ -89,7 +97,36 @@ class Shader {
         /// @param useShader boolean to indicate whether to use this shader
         void setMatrix4(const char *name, const glm::mat4 &matrix) const;
 
+        // ------------------------------------------------------------------------
+        // location-based utility functions (see getUniformLocation())
+        // ------------------------------------------------------------------------
+
+        /// @brief set a uniform float at a cached location
+        void setFloat(GLint location, float value) const;
+
+        /// @brief set a uniform integer at a cached location
+        void setInteger(GLint location, int value) const;
+
+        /// @brief set a uniform vector of two floats at a cached location
+        void setVector2f(GLint location, const glm::vec2 &value) const;
+
+        /// @brief set a uniform vector of three floats at a cached location
+        void setVector3f(GLint location, const glm::vec3 &value) const;
+
+        /// @brief set a uniform vector of four floats at a cached location
+        void setVector4f(GLint location, const glm::vec4 &value) const;
+
+        /// @brief set a uniform matrix of four floats at a cached location
+        void setMatrix4(GLint location, const glm::mat4 &matrix) const;
+
     private:
+        /// @brief Locations of every active uniform, filled in by compile() after linking
+        /// @details std::less<> lets the setters look up a const char * without building a std::string.
+        std::map<std::string, GLint, std::less<>> uniformLocations;
+
+        /// @brief Asks OpenGL for every active uniform in the program and caches its location
+        void cacheUniformLocations();
+
         /// @brief Checks if compilation or linking failed and if so, print the error logs
         /// @param object the shader object to check
         /// @param type the type of shader object (vertex, fragment, geometry)
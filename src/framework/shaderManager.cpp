@@ -1,13 +1,29 @@
 #include "shaderManager.h"
+#include "profiler.h"
 
 
+ShaderManager::ShaderManager() {
+    glGenBuffers(1, &frameUBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, frameUBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_BINDING, frameUBO);
+}
+
 ShaderManager::~ShaderManager() {
     clear();
+    glDeleteBuffers(1, &frameUBO);
 }
 
 Shader ShaderManager::loadShader(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile,
                                  std::string name) {
     shaders[name] = loadShaderFromFile(vShaderFile, fShaderFile, gShaderFile);
+
+    // Point the shader's "Frame" block (if it has one) at the shared frame uniform buffer
+    GLuint frameBlock = glGetUniformBlockIndex(shaders[name].ID, "Frame");
+    if (frameBlock != GL_INVALID_INDEX)
+        glUniformBlockBinding(shaders[name].ID, frameBlock, FRAME_BINDING);
+
     return shaders[name];
 }
 
@@ -22,6 +38,13 @@ void ShaderManager::clear() {
         glDeleteProgram(iter.second.ID);
 }
 
+void ShaderManager::updateFrameUniforms(const FrameUniforms &frame) {
+    glBindBuffer(GL_UNIFORM_BUFFER, frameUBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniforms), &frame);
+    Profiler::countUniformUpload();
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
 Shader ShaderManager::loadShaderFromFile(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile) {
     // 1. retrieve the vertex/fragment source code from filePath
     std::string vertexCode;
@@ -9,10 +9,23 @@
 #include <fstream>
 #include <sstream>
 
+/// @brief Frame-global state shared by every shader through the "Frame" uniform block.
+/// @details Laid out to match the block's std140 layout (mat4 at 0, vec2 at 64, floats at 72 and 76).
+struct FrameUniforms {
+    glm::mat4 projection;
+    glm::vec2 viewport;
+    float time;
+    float deltaTime;
+};
+
 class ShaderManager {
 public:
-    /// @brief Default constructor
-    ShaderManager() = default;
+    /// @brief Uniform buffer binding point the "Frame" block of every loaded shader is bound to
+    static const GLuint FRAME_BINDING = 0;
+
+    /// @brief Creates the frame uniform buffer and binds it to FRAME_BINDING
+    /// @note Requires a current OpenGL context.
+    ShaderManager();
     /// @brief Default destructor
     /// @details Clears the shaders map
     ~ShaderManager();
@@ -34,10 +47,18 @@ public:
      /// @brief Clears the shaders map
     void clear();
 
+    /// @brief Uploads the frame-global state once for every shader
+    /// @details Call once per frame before drawing.
+    /// @param frame The projection, viewport size, elapsed time and delta time for this frame
+    void updateFrameUniforms(const FrameUniforms &frame);
+
 private:
     /// @brief A map of shaders, with the key being the name of the shader
     std::map<std::string, Shader> shaders;
 
+    /// @brief The uniform buffer backing every shader's "Frame" block
+    GLuint frameUBO = 0;
+
      /// @brief Loads and compiles a shader from a file
      /// @details This function is private because we only want to load shaders from within this class
      /// @param vShaderFile The vertex shader file
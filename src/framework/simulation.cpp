@@ -0,0 +1,201 @@
+#include "simulation.h"
+#include "cornerPredictor.h"
+#include "sweep.h"
+
+#include <cmath>
+
+Simulation::Simulation(vec2 bounds, Logo logo, StepMode mode) : bounds(bounds), logo(logo), mode(mode) {}
+
+unsigned int Simulation::step(float deltaTime) {
+    if (mode == StepMode::Clamp)
+        return checkBounds(logo, bounds, deltaTime, wallsHit, cornersHit);
+
+    lastCorners.clear();
+    return advanceExact(logo, bounds, deltaTime, wallsHit, cornersHit, &lastCorners);
+}
+
+unsigned int Simulation::checkBounds(Logo &logo, vec2 bounds, float deltaTime, long long &wallsHit, long long &cornersHit) {
+    // Get position, velocity, and size of the moving rectangle
+    dvec2 position = logo.pos;
+    dvec2 velocity = logo.velocity;
+    vec2 size = logo.size;
+    float WIDTH = bounds.x, HEIGHT = bounds.y;
+    unsigned int corners = 0;
+
+    // Get new position
+    position += velocity * double(deltaTime);
+
+    // If the rectangle hits the edges of the screen, bounce it in the other direction
+    if (position.x - (size.x / 2) <= 0) {  // Hits left wall
+        position.x = (size.x / 2);
+        velocity.x = -velocity.x;
+        wallsHit++;
+    }
+    if (position.x + (size.x / 2) >= WIDTH) {  // Hits right wall
+        position.x = WIDTH - (size.x / 2);
+        velocity.x = -velocity.x;
+        wallsHit++;
+    }
+    if (position.y - (size.y / 2) <= 0) {  // Hits bottom wall
+        position.y = (size.y / 2);
+        velocity.y = -velocity.y;
+        wallsHit++;
+    }
+    if (position.y + (size.y / 2) >= HEIGHT) {  // Hits top wall
+        position.y = HEIGHT - (size.y / 2);
+        velocity.y = -velocity.y;
+        wallsHit++;
+    }
+
+    // Determine if a corner has been hit
+    if (position.x - (size.x / 2) <= 0 && position.y - (size.y / 2) <= 0) {
+        corners++;
+    }
+    if (position.x + (size.x / 2) >= WIDTH && position.y - (size.y / 2) <= 0) {
+        corners++;
+    }
+    if (position.x - (size.x / 2) <= 0 && position.y + (size.y / 2) >= HEIGHT) {
+        corners++;
+    }
+    if (position.x + (size.x / 2) >= WIDTH && position.y + (size.y / 2) >= HEIGHT) {
+        corners++;
+    }
+    cornersHit += corners;
+
+    // Set the new position and velocity of the moving rectangle
+    logo.pos = position;
+    logo.velocity = velocity;
+    return corners;
+}
+
+unsigned int Simulation::advanceExact(Logo &logo, vec2 bounds, double duration, long long &wallsHit, long long &cornersHit,
+                                      vector<CornerHit> *corners) {
+    // Range of the logo's center on each axis
+    double lowX = logo.size.x / 2, highX = bounds.x - logo.size.x / 2;
+    double lowY = logo.size.y / 2, highY = bounds.y - logo.size.y / 2;
+
+    double x = logo.pos.x, y = logo.pos.y;
+    double velocityX = logo.velocity.x, velocityY = logo.velocity.y;
+    double elapsed = 0;
+    unsigned int cornerCount = 0;
+
+    while (true) {
+        double timeX = timeToWall(x, velocityX, lowX, highX);
+        double timeY = timeToWall(y, velocityY, lowY, highY);
+        double time = timeX < timeY ? timeX : timeY;
+
+        // No more hits in this step: move the rest of the way
+        if (elapsed + time > duration) {
+            double rest = duration - elapsed;
+            x += velocityX * rest;
+            y += velocityY * rest;
+            break;
+        }
+
+        // Move to the hit and bounce every axis that hits a wall now
+        elapsed += time;
+        bool hitX = timeX - time <= CORNER_TOLERANCE;
+        bool hitY = timeY - time <= CORNER_TOLERANCE;
+        if (hitX) {
+            x = velocityX > 0 ? highX : lowX;
+            velocityX = -velocityX;
+            wallsHit++;
+        } else {
+            x += velocityX * time;
+        }
+        if (hitY) {
+            y = velocityY > 0 ? highY : lowY;
+            velocityY = -velocityY;
+            wallsHit++;
+        } else {
+            y += velocityY * time;
+        }
+
+        if (hitX && hitY) {
+            cornerCount++;
+            if (corners) {
+                // The velocity was reversed above, so it now points away from the corner's walls
+                bool right = velocityX < 0, top = velocityY < 0;
+                corners->push_back({elapsed, top ? (right ? Corner::TopRight : Corner::TopLeft)
+                                                 : (right ? Corner::BottomRight : Corner::BottomLeft)});
+            }
+        }
+    }
+    cornersHit += cornerCount;
+
+    logo.pos = dvec2(x, y);
+    logo.velocity = dvec2(velocityX, velocityY);
+    return cornerCount;
+}
+
+/// @brief Moves one axis of the logo for time seconds along its exact path
+/// @details The path is unfolded into a straight line, so the number of bounces is the distance travelled
+/// divided by the distance between the walls, and the final position is the remainder folded back.
+/// @return The number of wall hits
+static long long moveAxis(double &pos, double &velocity, double low, double high, double time) {
+    double length = high - low;
+    if (velocity == 0 || length <= 0)
+        return 0;
+
+    // Distance from the wall the logo is moving away from, plus the distance travelled
+    double start = velocity > 0 ? pos - low : high - pos;
+    start = start < 0 ? 0 : (start > length ? length : start);
+    double distance = start + std::fabs(velocity) * time;
+
+    double hits = std::floor(distance / length);
+    double rest = distance - hits * length;
+    bool reversed = std::fmod(hits, 2) != 0;
+
+    // An even number of hits leaves the logo heading the same way, an odd number turns it around
+    double offset = reversed ? length - rest : rest;
+    pos = velocity > 0 ? low + offset : high - offset;
+    if (reversed)
+        velocity = -velocity;
+    return static_cast<long long>(hits);
+}
+
+long long Simulation::fastForward(double duration) {
+    double lowX = logo.size.x / 2, highX = bounds.x - logo.size.x / 2;
+    double lowY = logo.size.y / 2, highY = bounds.y - logo.size.y / 2;
+    double elapsed = 0;
+    long long corners = 0;
+
+    // Jump from corner to corner
+    CornerHit hit;
+    while (CornerPredictor(logo, bounds).nextCornerHit(hit, CORNER_TOLERANCE) && elapsed + hit.time <= duration) {
+        wallsHit += moveAxis(logo.pos.x, logo.velocity.x, lowX, highX, hit.time);
+        wallsHit += moveAxis(logo.pos.y, logo.velocity.y, lowY, highY, hit.time);
+
+        // One axis may be up to CORNER_TOLERANCE short of its wall: finish that bounce and snap both axes
+        // into the corner, so the next prediction starts cleanly from it
+        bool right = hit.corner == Corner::BottomRight || hit.corner == Corner::TopRight;
+        bool top = hit.corner == Corner::TopLeft || hit.corner == Corner::TopRight;
+        if ((logo.velocity.x > 0) == right) {
+            logo.velocity.x = -logo.velocity.x;
+            wallsHit++;
+        }
+        if ((logo.velocity.y > 0) == top) {
+            logo.velocity.y = -logo.velocity.y;
+            wallsHit++;
+        }
+        logo.pos = dvec2(right ? highX : lowX, top ? highY : lowY);
+
+        elapsed += hit.time;
+        corners++;
+    }
+
+    // No corner in what's left
+    wallsHit += moveAxis(logo.pos.x, logo.velocity.x, lowX, highX, duration - elapsed);
+    wallsHit += moveAxis(logo.pos.y, logo.velocity.y, lowY, highY, duration - elapsed);
+    cornersHit += corners;
+    return corners;
+}
+
+const Logo &Simulation::getLogo() const { return logo; }
+void Simulation::setVelocity(dvec2 v)    { logo.velocity = v; }
+vec2 Simulation::getBounds() const       { return bounds; }
+StepMode Simulation::getStepMode() const { return mode; }
+void Simulation::setStepMode(StepMode m) { mode = m; }
+const vector<CornerHit> &Simulation::getLastCorners() const { return lastCorners; }
+long long Simulation::getWallsHit() const   { return wallsHit; }
+long long Simulation::getCornersHit() const { return cornersHit; }
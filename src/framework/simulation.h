@@ -0,0 +1,133 @@
+#ifndef GRAPHICS_SIMULATION_H
+#define GRAPHICS_SIMULATION_H
+
+#include <vector>
+#include <glm/glm.hpp>
+
+using glm::vec2, glm::dvec2;
+using std::vector;
+
+/// @brief State of a bouncing logo.
+/// @details Position and velocity are doubles: in single precision the rounding of every tick's move adds up to
+/// whole units after a few thousand bounces, which is enough to turn a corner hit into a near miss.
+struct Logo {
+    /// @brief Position of the logo's center
+    dvec2 pos;
+    /// @brief The x and y velocities of the logo (units per second)
+    dvec2 velocity;
+    /// @brief Width and height of the logo
+    vec2 size;
+};
+
+/// @brief The four walls of the box.
+enum class Wall { Left, Right, Bottom, Top };
+
+/// @brief The four corners of the box.
+enum class Corner { BottomLeft, BottomRight, TopLeft, TopRight };
+
+/// @brief A wall hit, in seconds from the predictor's starting state.
+struct WallHit {
+    double time;
+    Wall wall;
+};
+
+/// @brief A corner hit, in seconds from the predictor's starting state.
+struct CornerHit {
+    double time;
+    Corner corner;
+};
+
+/// @brief How Simulation::step() moves the logo.
+enum class StepMode {
+    /// @brief Move by velocity * deltaTime and clamp against any wall the logo passed (the original rules)
+    Clamp,
+    /// @brief Find the exact time of every wall hit within the step and bounce in order
+    Event
+};
+
+/**
+ * @brief The bouncing-logo simulation, independent of rendering
+ * @details Holds the logo and the walls/corners counters and advances them in fixed ticks using the
+ * checkBounds() rules. Nothing here touches OpenGL or GLFW, so the same rules run on screen, in headless
+ * mode and in batch tools, and identical inputs give identical results on every machine.
+ */
+class Simulation {
+    public:
+        /// @brief Construct a new Simulation object
+        /// @param bounds Width and height of the box the logo bounces in (the window size)
+        /// @param logo The starting state of the logo
+        Simulation(vec2 bounds, Logo logo, StepMode mode = StepMode::Clamp);
+
+        /// @brief The largest gap, in seconds, between an x and a y wall hit that counts as a corner in event mode
+        static constexpr double CORNER_TOLERANCE = 1e-4;
+
+        /// @brief Advances the simulation by one tick
+        /// @param deltaTime Length of the tick in seconds
+        /// @return The number of corners hit during this tick
+        unsigned int step(float deltaTime);
+
+        /// @brief Moves the logo by velocity * deltaTime and bounces it off the walls
+        /// @details A wall is hit when the logo's edge reaches or passes it; the logo is then clamped against
+        /// the wall and that velocity component is reversed. A corner is hit when the logo ends the tick
+        /// touching two walls at once.
+        /// @param logo The logo to move
+        /// @param bounds Width and height of the box
+        /// @param deltaTime Length of the tick in seconds
+        /// @param wallsHit Incremented once per wall hit
+        /// @param cornersHit Incremented once per corner hit
+        /// @return The number of corners hit during this tick
+        static unsigned int checkBounds(Logo &logo, vec2 bounds, float deltaTime, long long &wallsHit, long long &cornersHit);
+
+        /// @brief Moves the logo along its exact path for duration seconds, bouncing off each wall at its time of impact
+        /// @details Wall hits are processed in time order, so nothing tunnels or is counted twice however fast the
+        /// logo moves, and corners in the middle of a step are found. The cost is O(number of bounces), not O(ticks).
+        /// @param logo The logo to move
+        /// @param bounds Width and height of the box
+        /// @param duration Seconds to advance
+        /// @param wallsHit Incremented once per wall hit
+        /// @param cornersHit Incremented once per corner hit
+        /// @param corners If not null, each corner hit is appended with its time from the start of the call
+        /// @return The number of corners hit
+        static unsigned int advanceExact(Logo &logo, vec2 bounds, double duration, long long &wallsHit, long long &cornersHit,
+                                         vector<CornerHit> *corners = nullptr);
+
+        /// @brief Advances the simulation by duration seconds in closed form, without stepping
+        /// @details Follows the same exact path as advanceExact(), but wall hits are counted per axis with a
+        /// division and each corner is found directly with CornerPredictor, so the cost grows with the number
+        /// of corners rather than the number of bounces or ticks. Weeks of screensaver take milliseconds.
+        /// @param duration Seconds to advance
+        /// @return The number of corners hit
+        long long fastForward(double duration);
+
+        // --------------------------------------------------------
+        // Getters/Setters
+        // --------------------------------------------------------
+        const Logo &getLogo() const;
+        void setVelocity(dvec2 velocity);
+        vec2 getBounds() const;
+        StepMode getStepMode() const;
+        void setStepMode(StepMode mode);
+        /// @brief Corners hit during the last step() in event mode, with their time from the start of that step
+        const vector<CornerHit> &getLastCorners() const;
+        long long getWallsHit() const;
+        long long getCornersHit() const;
+
+    private:
+        /// @brief Width and height of the box the logo bounces in
+        vec2 bounds;
+
+        /// @brief The bouncing logo
+        Logo logo;
+
+        /// @brief How step() moves the logo
+        StepMode mode;
+
+        /// @brief Corners hit during the last step() (event mode only)
+        vector<CornerHit> lastCorners;
+
+        // Keep track of walls and corners (64-bit, fastForward() can cover years of bounces)
+        long long wallsHit = 0;
+        long long cornersHit = 0;
+};
+
+#endif //GRAPHICS_SIMULATION_H
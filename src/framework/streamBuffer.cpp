@@ -0,0 +1,158 @@
+#include "streamBuffer.h"
+
+#include <cstring>
+#include <iostream>
+
+StreamBuffer::StreamBuffer(GLenum target, size_t capacity) : target(target) {
+    allocate(capacity > 0 ? capacity : 1);
+}
+
+StreamBuffer::~StreamBuffer() {
+    clearSegments();
+    if (mapped) {
+        glBindBuffer(target, buffer);
+        glUnmapBuffer(target);
+        glBindBuffer(target, 0);
+    }
+    glDeleteBuffers(1, &buffer);
+}
+
+void StreamBuffer::allocate(size_t newCapacity) {
+    // Fences on the old storage no longer matter: the driver keeps it alive until the GPU is done with it
+    clearSegments();
+    capacity = newCapacity;
+    head = 0;
+    segmentStart = 0;
+
+#ifdef GL_ARB_buffer_storage
+    if (GLAD_GL_ARB_buffer_storage) {
+        // Immutable storage can't be resized, so growing means a new buffer
+        if (buffer != 0) {
+            glBindBuffer(target, buffer);
+            glUnmapBuffer(target);
+            glDeleteBuffers(1, &buffer);
+        }
+        glGenBuffers(1, &buffer);
+        glBindBuffer(target, buffer);
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(target, capacity, NULL, flags);
+        mapped = static_cast<char*>(glMapBufferRange(target, 0, capacity, flags));
+        if (mapped)
+            return;
+        std::cout << "ERROR::STREAM_BUFFER: Failed to map buffer persistently" << std::endl;
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+#endif
+
+    if (buffer == 0)
+        glGenBuffers(1, &buffer);
+    glBindBuffer(target, buffer);
+    glBufferData(target, capacity, NULL, GL_STREAM_DRAW);
+}
+
+void *StreamBuffer::map(size_t size, size_t alignment, size_t &offset) {
+    offset = (head + alignment - 1) / alignment * alignment;
+
+    if (offset + size > capacity) {
+        if (size > capacity) {
+            // Doesn't fit even in an empty ring: orphan it for a bigger one
+            size_t newCapacity = capacity * 2;
+            while (newCapacity < size * FRAMES_IN_FLIGHT)
+                newCapacity *= 2;
+            allocate(newCapacity);
+        } else {
+            // Wrap around; fence what was written up to here first so a segment never spans the end
+            fence();
+            head = 0;
+            segmentStart = 0;
+        }
+        offset = 0;
+    }
+
+    waitFor(offset, offset + size);
+    head = offset + size;
+
+    glBindBuffer(target, buffer);
+    if (mapped)
+        return mapped + offset;
+
+    // The fences already guarantee the GPU isn't reading this range, so skip the driver's synchronization
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+    void *destination = glMapBufferRange(target, offset, size, flags);
+    if (!destination) {
+        std::cout << "ERROR::STREAM_BUFFER: Failed to map range" << std::endl;
+        return nullptr;
+    }
+    rangeMapped = true;
+    return destination;
+}
+
+void StreamBuffer::unmap() {
+    if (!rangeMapped)
+        return;
+    glBindBuffer(target, buffer);
+    glUnmapBuffer(target);
+    rangeMapped = false;
+}
+
+size_t StreamBuffer::append(const void *data, size_t size, size_t alignment) {
+    size_t offset;
+    void *destination = map(size, alignment, offset);
+    if (destination) {
+        std::memcpy(destination, data, size);
+        unmap();
+    } else {
+        glBufferSubData(target, offset, size, data);
+    }
+    return offset;
+}
+
+void StreamBuffer::fence() {
+    if (head <= segmentStart)
+        return;
+    segments.push_back({glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), segmentStart, head});
+    segmentStart = head;
+}
+
+void StreamBuffer::waitFor(size_t begin, size_t end) {
+    // The segment in the way isn't necessarily at the front: older ones can sit in an alignment gap or past the end
+    // of the last lap. Fences are passed in the order they were inserted, so waiting on the newest one in the way
+    // covers every older one as well.
+    size_t count = 0;
+    for (size_t i = 0; i < segments.size(); i++) {
+        if (segments[i].begin < end && segments[i].end > begin)
+            count = i + 1;
+    }
+    if (count == 0)
+        return;
+
+    GLsync sync = segments[count - 1].sync;
+    GLenum result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    while (result == GL_TIMEOUT_EXPIRED)
+        result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+    if (result == GL_WAIT_FAILED)
+        std::cout << "ERROR::STREAM_BUFFER: Failed to wait on fence" << std::endl;
+
+    for (size_t i = 0; i < count; i++)
+        glDeleteSync(segments[i].sync);
+    segments.erase(segments.begin(), segments.begin() + count);
+}
+
+bool StreamBuffer::overlapsPending(size_t begin, size_t end) const {
+    for (const Segment &segment : segments) {
+        if (segment.begin < end && segment.end > begin)
+            return true;
+    }
+    return false;
+}
+
+void StreamBuffer::clearSegments() {
+    for (const Segment &segment : segments)
+        glDeleteSync(segment.sync);
+    segments.clear();
+}
+
+GLuint StreamBuffer::getBuffer() const  { return buffer; }
+size_t StreamBuffer::getCapacity() const { return capacity; }
+bool StreamBuffer::isPersistent() const  { return mapped != nullptr; }
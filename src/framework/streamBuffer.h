@@ -0,0 +1,106 @@
+#ifndef GRAPHICS_STREAMBUFFER_H
+#define GRAPHICS_STREAMBUFFER_H
+
+#include <cstddef>
+#include <deque>
+#include <glad/glad.h>
+
+/**
+ * @brief A ring buffer for geometry that is rewritten every frame
+ * @details Each append() (or map()/unmap() pair) writes into the next free region of one large buffer and returns
+ * its byte offset, so the caller draws from that offset instead of re-uploading over data the GPU may still be
+ * reading. After issuing the draws that read a region, the caller calls fence(); a region is only written again once
+ * the GPU has passed the fence that covers it, which is what lets the writes skip the driver's own synchronization
+ * (GL_MAP_UNSYNCHRONIZED_BIT). With ARB_buffer_storage the buffer is mapped once, persistently, and writing is a
+ * plain memcpy.
+ *
+ * Draw from a region before writing the next one. The buffer should hold a few frames' worth of data so the CPU never
+ * has to wait; a region that doesn't fit at all reallocates (orphans) the buffer at a larger size, which may change
+ * getBuffer(), so bind getBuffer() after writing rather than caching it.
+ */
+class StreamBuffer {
+    public:
+        /// @brief Frames the ring should have room for, when sizing it from one frame's data
+        static const size_t FRAMES_IN_FLIGHT = 3;
+
+        /// @brief Construct a new Stream Buffer object
+        /// @param target The binding point the buffer is used on (e.g. GL_ARRAY_BUFFER)
+        /// @param capacity The size of the ring in bytes
+        StreamBuffer(GLenum target, size_t capacity);
+
+        /// @brief Destroy the Stream Buffer object
+        /// @details Unmaps and deletes the buffer along with any fences still pending
+        ~StreamBuffer();
+
+        StreamBuffer(const StreamBuffer &) = delete;
+        StreamBuffer &operator=(const StreamBuffer &) = delete;
+
+        /// @brief Reserves the next region of the ring and returns a pointer to write it through
+        /// @details Must be followed by unmap() before drawing. Leaves the buffer bound to the target.
+        /// @param size The number of bytes to reserve
+        /// @param alignment The offset is a multiple of this
+        /// @param offset Set to the byte offset of the region in getBuffer()
+        /// @return Where to write the region's data, or nullptr if it couldn't be mapped
+        void *map(size_t size, size_t alignment, size_t &offset);
+
+        /// @brief Finishes writing the region returned by map()
+        void unmap();
+
+        /// @brief Copies data into the next region of the ring
+        /// @details Leaves the buffer bound to the target.
+        /// @param data The data to copy
+        /// @param size The number of bytes to copy
+        /// @param alignment The returned offset is a multiple of this (the vertex size, to draw from offset / size)
+        /// @return The byte offset of the data in getBuffer()
+        size_t append(const void *data, size_t size, size_t alignment = 16);
+
+        /// @brief Marks everything appended so far as in use by the draws issued since
+        /// @details Call after the draw calls that read the appended data.
+        void fence();
+
+        // --------------------------------------------------------
+        // Getters
+        // --------------------------------------------------------
+        GLuint getBuffer() const;
+        size_t getCapacity() const;
+        /// @brief Whether the buffer is persistently mapped (ARB_buffer_storage) rather than mapped per append()
+        bool isPersistent() const;
+        /// @brief Whether a fenced region the GPU may still be reading overlaps [begin, end)
+        /// @details Always false for a region map() or append() just returned; graphics_bench checks that it is.
+        bool overlapsPending(size_t begin, size_t end) const;
+
+    private:
+        /// @brief A region of the ring and the fence the GPU passes once it's done reading it
+        struct Segment {
+            GLsync sync;
+            size_t begin, end;
+        };
+
+        GLenum target;
+        GLuint buffer = 0;
+        size_t capacity = 0;
+
+        /// @brief Where the next append() starts, and where the writes not yet covered by a fence start
+        size_t head = 0;
+        size_t segmentStart = 0;
+
+        /// @brief Fenced regions, oldest first
+        std::deque<Segment> segments;
+
+        /// @brief The persistent mapping, or nullptr when each map() maps its own range
+        char *mapped = nullptr;
+
+        /// @brief Whether map() mapped a range that unmap() has to unmap
+        bool rangeMapped = false;
+
+        /// @brief Creates (or recreates) the buffer with room for capacity bytes and forgets every fence
+        void allocate(size_t capacity);
+
+        /// @brief Waits until the GPU is done with every fenced region overlapping [begin, end)
+        void waitFor(size_t begin, size_t end);
+
+        /// @brief Deletes the fences without waiting on them
+        void clearSegments();
+};
+
+#endif //GRAPHICS_STREAMBUFFER_H
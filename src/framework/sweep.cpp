@@ -0,0 +1,97 @@
+#include "sweep.h"
+
+#include <cmath>
+
+double timeToWall(double pos, double velocity, double low, double high) {
+    if (velocity == 0 || high <= low)
+        return INFINITY;
+    double time = velocity > 0 ? (high - pos) / velocity : (low - pos) / velocity;
+    return time > 0 ? time : 0; // Already on or past the wall
+}
+
+bool sweepCircles(dvec2 posA, dvec2 velocityA, double radiusA, dvec2 posB, dvec2 velocityB, double radiusB,
+                  double maxTime, double &time) {
+    // Work in A's frame: B starts at delta and moves with the relative velocity
+    dvec2 delta = posB - posA;
+    dvec2 velocity = velocityB - velocityA;
+    double radiusSum = radiusA + radiusB;
+
+    double approach = glm::dot(delta, velocity);
+    if (approach >= 0)
+        return false; // Moving apart (or not moving)
+
+    double gap = glm::dot(delta, delta) - radiusSum * radiusSum;
+    if (gap <= 0) {
+        time = 0; // Already touching
+        return true;
+    }
+
+    // |delta + velocity t|^2 = radiusSum^2 is a quadratic in t; the smaller root is the first touch
+    double a = glm::dot(velocity, velocity);
+    double discriminant = approach * approach - a * gap;
+    if (discriminant < 0)
+        return false; // Passes by without touching
+
+    time = (-approach - std::sqrt(discriminant)) / a;
+    return time <= maxTime;
+}
+
+bool sweepBoxes(dvec2 posA, dvec2 velocityA, vec2 sizeA, dvec2 posB, dvec2 velocityB, vec2 sizeB,
+                double maxTime, double &time, int &axis) {
+    dvec2 delta = posB - posA;
+    dvec2 velocity = velocityB - velocityA;
+
+    // Time range during which each axis overlaps
+    double enter[2], exit[2];
+    for (int i = 0; i < 2; i++) {
+        double extent = (sizeA[i] + sizeB[i]) / 2.0;
+        if (velocity[i] == 0) {
+            if (std::fabs(delta[i]) >= extent)
+                return false; // Never overlaps on this axis
+            enter[i] = -INFINITY;
+            exit[i] = INFINITY;
+        } else {
+            double first = (-extent - delta[i]) / velocity[i];
+            double second = (extent - delta[i]) / velocity[i];
+            enter[i] = first < second ? first : second;
+            exit[i] = first < second ? second : first;
+        }
+    }
+
+    // The boxes touch once both axes overlap, and the axis that starts overlapping last is the one they meet on
+    axis = enter[0] > enter[1] ? 0 : 1;
+    double start = enter[axis];
+    double end = exit[0] < exit[1] ? exit[0] : exit[1];
+    if (start >= end || end <= 0 || start > maxTime)
+        return false;
+
+    // Already overlapping: only count it if they are still closing in on that axis
+    if (start < 0 && delta[axis] * velocity[axis] >= 0)
+        return false;
+
+    time = start > 0 ? start : 0;
+    return true;
+}
+
+void CollisionQueue::reset(size_t bodies) {
+    events = {};
+    versions.assign(bodies, 0);
+}
+
+void CollisionQueue::push(double time, unsigned int a, unsigned int b, int axis) {
+    events.push({time, a, b, axis, versions[a], b == WALL ? 0 : versions[b]});
+}
+
+bool CollisionQueue::pop(Event &event) {
+    while (!events.empty()) {
+        event = events.top();
+        events.pop();
+        if (event.versionA == versions[event.a] && (event.b == WALL || event.versionB == versions[event.b]))
+            return true;
+    }
+    return false;
+}
+
+void CollisionQueue::touch(unsigned int body) {
+    versions[body]++;
+}
@@ -0,0 +1,83 @@
+#ifndef GRAPHICS_SWEEP_H
+#define GRAPHICS_SWEEP_H
+
+#include <queue>
+#include <vector>
+#include <glm/glm.hpp>
+
+using std::vector, glm::vec2, glm::dvec2;
+
+/// @brief Seconds until a point moving along one axis reaches the wall it is moving towards
+/// @param pos Current position
+/// @param velocity Velocity along the axis
+/// @param low Lowest position allowed (the low wall, inset by the shape's half size)
+/// @param high Highest position allowed
+/// @return 0 if it is already on or past that wall, INFINITY if it isn't moving or can't move
+double timeToWall(double pos, double velocity, double low, double high);
+
+/// @brief Finds when two moving circles first touch
+/// @details Solves |(posB - posA) + (velocityB - velocityA) t| = radiusA + radiusB for the earliest t. Circles that
+/// already overlap and are still approaching touch at t = 0.
+/// @param maxTime Only impacts in [0, maxTime] count
+/// @param time Set to the time of impact
+/// @return false if they don't touch within maxTime (or are moving apart)
+bool sweepCircles(dvec2 posA, dvec2 velocityA, double radiusA, dvec2 posB, dvec2 velocityB, double radiusB,
+                  double maxTime, double &time);
+
+/// @brief Finds when two moving axis-aligned boxes first touch
+/// @details Intersects the times each axis overlaps (the slab method on the boxes' Minkowski sum). Boxes that
+/// already overlap and are still approaching touch at t = 0.
+/// @param sizeA Width and height of box A (posA is its center)
+/// @param sizeB Width and height of box B
+/// @param maxTime Only impacts in [0, maxTime] count
+/// @param time Set to the time of impact
+/// @param axis Set to the axis the boxes meet on (0 for x, 1 for y)
+/// @return false if they don't touch within maxTime (or are moving apart)
+bool sweepBoxes(dvec2 posA, dvec2 velocityA, vec2 sizeA, dvec2 posB, dvec2 velocityB, vec2 sizeB,
+                double maxTime, double &time, int &axis);
+
+/**
+ * @brief A time-ordered queue of collision events for continuous collision detection
+ * @details Events are processed earliest first. When a body changes course its version is bumped with touch(), which
+ * makes every event already queued for it stale; pop() skips those, so the caller only has to queue the new events
+ * of the bodies an event changed.
+ */
+class CollisionQueue {
+    public:
+        /// @brief Stand-in for the second body of a wall event
+        static const unsigned int WALL = ~0u;
+
+        /// @brief A pending impact between bodies a and b (or a and a wall) on an axis
+        struct Event {
+            double time;
+            unsigned int a, b;
+            int axis;
+            unsigned int versionA, versionB;
+        };
+
+        /// @brief Empties the queue and makes room for bodies
+        void reset(size_t bodies);
+
+        /// @brief Queues an impact between a and b (WALL for a wall) at time
+        void push(double time, unsigned int a, unsigned int b, int axis = 0);
+
+        /// @brief Takes the earliest event that is still valid
+        /// @return false if there are none left
+        bool pop(Event &event);
+
+        /// @brief Invalidates every queued event of body
+        void touch(unsigned int body);
+
+    private:
+        /// @brief Orders the heap so the earliest event is on top
+        struct Later {
+            bool operator()(const Event &a, const Event &b) const { return a.time > b.time; }
+        };
+
+        std::priority_queue<Event, vector<Event>, Later> events;
+
+        /// @brief Current version of each body
+        vector<unsigned int> versions;
+};
+
+#endif //GRAPHICS_SWEEP_H
@@ -0,0 +1,55 @@
+#include "textLayout.h"
+#include "profiler.h"
+
+TextLayout::TextLayout(FontRenderer &fontRenderer, const std::string &text, float x, float y, float scale,
+                       glm::vec3 color) : fontRenderer(fontRenderer), text(text), x(x), y(y), scale(scale), color(color) {
+    glGenVertexArrays(1, &this->VAO);
+    glGenBuffers(1, &this->VBO);
+    glBindVertexArray(this->VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
+    FontRenderer::initVertexAttributes();
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    this->layout();
+}
+
+TextLayout::~TextLayout() {
+    glDeleteVertexArrays(1, &this->VAO);
+    glDeleteBuffers(1, &this->VBO);
+}
+
+void TextLayout::setText(const std::string &text) {
+    if (text == this->text)
+        return;
+
+    this->text = text;
+    this->layout();
+}
+
+const std::string &TextLayout::getText() const {
+    return text;
+}
+
+void TextLayout::layout() {
+    std::vector<float> vertices;
+    fontRenderer.layoutText(text, x, y, scale, color, vertices);
+    vertexCount = vertices.size() / FontRenderer::VERTEX_SIZE;
+
+    // The layout only changes when the text does, so the buffer is static between changes
+    glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void TextLayout::draw() const {
+    if (vertexCount == 0)
+        return;
+
+    fontRenderer.use();
+    glBindVertexArray(this->VAO);
+    glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+    Profiler::countDrawCall();
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
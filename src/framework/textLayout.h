@@ -0,0 +1,86 @@
+#ifndef GRAPHICS_TEXTLAYOUT_H
+#define GRAPHICS_TEXTLAYOUT_H
+
+#include <string>
+#include <vector>
+
+#include "fontRenderer.h"
+
+/**
+ * @brief A pre-shaped text label
+ * @details The glyph quads for the label are laid out once and kept in the label's own vertex buffer,
+ * so drawing it is a single draw call with no CPU layout. The layout is only rebuilt when setText()
+ * is given different text.
+ */
+class TextLayout {
+    public:
+        /**
+         * @brief Construct a new Text Layout object and lay out its text
+         *
+         * @param fontRenderer The font renderer providing the glyphs, shader and atlas
+         * @param text The text to display
+         * @param x The x position of the text
+         * @param y The y position of the text
+         * @param scale The scale of the text
+         * @param color The color of the text
+         */
+        TextLayout(FontRenderer &fontRenderer, const std::string &text, float x, float y, float scale,
+                   glm::vec3 color);
+
+        /**
+         * @brief Destroy the Text Layout object
+         * @details destroys the VAO and VBO associated with the label
+         */
+        ~TextLayout();
+
+        TextLayout(const TextLayout&) = delete;
+        TextLayout& operator=(const TextLayout&) = delete;
+
+        /**
+         * @brief Changes the label's text
+         * @details Does nothing if the text is the same as the current text
+         *
+         * @param text The new text
+         */
+        void setText(const std::string &text);
+
+        /**
+         * @brief Returns the label's current text
+         */
+        const std::string &getText() const;
+
+        /**
+         * @brief Draws the label in one draw call
+         */
+        void draw() const;
+
+    private:
+        /**
+         * @brief The font renderer providing the glyphs, shader and atlas
+         */
+        FontRenderer &fontRenderer;
+
+        /**
+         * @brief The text and where/how it is laid out
+         */
+        std::string text;
+        float x, y, scale;
+        glm::vec3 color;
+
+        /**
+         * @brief The VAO and VBO holding the laid out glyph quads
+         */
+        GLuint VAO, VBO;
+
+        /**
+         * @brief The number of vertices in the VBO
+         */
+        GLsizei vertexCount = 0;
+
+        /**
+         * @brief Lays out the current text and uploads it to the VBO
+         */
+        void layout();
+};
+
+#endif //GRAPHICS_TEXTLAYOUT_H
@@ -0,0 +1,79 @@
+#include "trace.h"
+
+#include <fstream>
+#include <iostream>
+
+TraceRecorder::TraceRecorder(size_t capacity) : epoch(Clock::now()), mainThread(threadId()) {
+    size_t size = 1;
+    while (size < capacity)
+        size *= 2;
+    slots = std::make_unique<Slot[]>(size);
+    mask = size - 1;
+}
+
+void TraceRecorder::record(const char *name, Clock::time_point start, Clock::time_point end) {
+    uint64_t ticket = next.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = slots[ticket & mask];
+
+    // Mark the slot as being written, fill it in, then publish it under its ticket
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(std::chrono::duration_cast<std::chrono::nanoseconds>(start - epoch).count(), std::memory_order_relaxed);
+    slot.duration.store(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(), std::memory_order_relaxed);
+    slot.thread.store(threadId(), std::memory_order_relaxed);
+    slot.sequence.store(ticket + 1, std::memory_order_release);
+}
+
+bool TraceRecorder::write(const std::string &path) const {
+    std::ofstream file(path);
+    if (!file) {
+        std::cout << "ERROR::TRACE: Failed to open " << path << std::endl;
+        return false;
+    }
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << mainThread << ",\"args\":{\"name\":\"Main\"}}";
+
+    // Oldest span still in the ring first
+    uint64_t end = next.load(std::memory_order_acquire);
+    uint64_t begin = end > mask + 1 ? end - (mask + 1) : 0;
+    file.setf(std::ios::fixed);
+    file.precision(3);
+    for (uint64_t ticket = begin; ticket < end; ticket++) {
+        const Slot &slot = slots[ticket & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != ticket + 1)
+            continue; // Still being written, or already overwritten by a newer span
+
+        const char *name = slot.name.load(std::memory_order_relaxed);
+        int64_t start = slot.start.load(std::memory_order_relaxed);
+        int64_t duration = slot.duration.load(std::memory_order_relaxed);
+        uint32_t thread = slot.thread.load(std::memory_order_relaxed);
+
+        // Re-check the sequence: if a writer claimed the slot meanwhile, what was just read may be torn
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != ticket + 1)
+            continue;
+
+        // Complete ("X") events, timestamps in microseconds
+        file << ",\n{\"name\":\"" << name << "\",\"cat\":\"engine\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread
+             << ",\"ts\":" << start / 1000.0 << ",\"dur\":" << duration / 1000.0 << "}";
+    }
+    file << "\n]}\n";
+
+    if (!file) {
+        std::cout << "ERROR::TRACE: Failed to write " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+uint64_t TraceRecorder::getRecorded() const {
+    return next.load(std::memory_order_relaxed);
+}
+
+uint32_t TraceRecorder::threadId() {
+    static std::atomic<uint32_t> threads{0};
+    thread_local uint32_t id = threads.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
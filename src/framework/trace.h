@@ -0,0 +1,90 @@
+#ifndef GRAPHICS_TRACE_H
+#define GRAPHICS_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Records timed spans into a ring buffer and writes them out as Chrome trace JSON
+ * @details Open the file in chrome://tracing or ui.perfetto.dev to see every frame's phases on a timeline.
+ * record() is lock-free and safe to call from any thread: each span claims a slot with one atomic increment and
+ * publishes it with a per-slot sequence number, so a writer never waits and a reader skips slots that are still being
+ * written. Once the ring is full the oldest spans are overwritten, so a long run keeps its last CAPACITY spans.
+ *
+ * Span names are stored as pointers and must outlive the recorder (string literals).
+ */
+class TraceRecorder {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// @brief Default number of spans kept (about 30 seconds of frames at 60 fps with ~30 spans each)
+        static const size_t CAPACITY = 1 << 16;
+
+        /// @brief Construct a new Trace Recorder object
+        /// @param capacity Number of spans to keep (rounded up to a power of two)
+        explicit TraceRecorder(size_t capacity = CAPACITY);
+
+        TraceRecorder(const TraceRecorder &) = delete;
+        TraceRecorder &operator=(const TraceRecorder &) = delete;
+
+        /// @brief Records a span that ran from start to end on the calling thread
+        void record(const char *name, Clock::time_point start, Clock::time_point end);
+
+        /// @brief Writes every span still in the ring as a Chrome trace (JSON object format)
+        /// @details Can be called while other threads are recording; spans written during the dump may be left out.
+        /// @param path The file to write
+        /// @return false if the file could not be written
+        bool write(const std::string &path) const;
+
+        /// @brief Returns the number of spans recorded so far (including overwritten ones)
+        uint64_t getRecorded() const;
+
+    private:
+        /// @brief One span; sequence is ticket + 1 once the slot holds the span with that ticket, 0 while it is written
+        struct Slot {
+            std::atomic<uint64_t> sequence{0};
+            std::atomic<const char *> name{nullptr};
+            std::atomic<int64_t> start{0}, duration{0};
+            std::atomic<uint32_t> thread{0};
+        };
+
+        std::unique_ptr<Slot[]> slots;
+        size_t mask;
+
+        /// @brief Ticket of the next span
+        std::atomic<uint64_t> next{0};
+
+        /// @brief Time 0 of the trace, and the thread that created the recorder (labelled "Main" in the trace)
+        Clock::time_point epoch;
+        uint32_t mainThread;
+
+        /// @brief Returns a small id for the calling thread, assigned the first time it records
+        static uint32_t threadId();
+};
+
+/**
+ * @brief Records a span for as long as it is in scope
+ * @details Does nothing when the recorder is null, so call sites don't have to check whether tracing is on.
+ */
+class TraceScope {
+    public:
+        TraceScope(TraceRecorder *trace, const char *name)
+            : trace(trace), name(name), start(trace ? TraceRecorder::Clock::now() : TraceRecorder::Clock::time_point()) {}
+        ~TraceScope() {
+            if (trace)
+                trace->record(name, start, TraceRecorder::Clock::now());
+        }
+
+        TraceScope(const TraceScope &) = delete;
+        TraceScope &operator=(const TraceScope &) = delete;
+
+    private:
+        TraceRecorder *trace;
+        const char *name;
+        TraceRecorder::Clock::time_point start;
+};
+
+#endif //GRAPHICS_TRACE_H
@@ -5,12 +5,37 @@
 
 
 int main(int argc, char *argv[]) {
-    Engine engine;
+    ArgumentStatus status;
+    EngineConfig config = parseArguments(argc, argv, status);
+    if (status != ArgumentStatus::Ok)
+        return status == ArgumentStatus::Help ? 0 : 1;
 
-    while (!engine.shouldClose()) {
-        engine.processInput();
-        engine.update();
-        engine.render();
+    // Batch mode: no window or GL, just the simulation
+    if (config.fastForward > 0) {
+        Simulation simulation = Engine::createSimulation(config);
+        simulation.fastForward(config.fastForward);
+
+        const Logo &logo = simulation.getLogo();
+        std::cout << "Walls Hit: " << simulation.getWallsHit() << "\n"
+                  << "Corners Hit: " << simulation.getCornersHit() << "\n"
+                  << "Position: " << logo.pos.x << ", " << logo.pos.y << "\n"
+                  << "Velocity: " << logo.velocity.x << ", " << logo.velocity.y << std::endl;
+        return 0;
+    }
+
+    // Replay: start with the settings the recording was made with
+    if (!config.replayPath.empty() && !InputReplay::loadConfig(config.replayPath, config))
+        return 1;
+
+    {
+        // Scoped so the engine frees its GL objects before the context is destroyed
+        Engine engine(config);
+
+        while (!engine.shouldClose()) {
+            engine.processInput();
+            engine.update();
+            engine.render();
+        }
     }
 
     glfwTerminate();
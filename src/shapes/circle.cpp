@@ -1,12 +1,9 @@
 #include "circle.h"
+#include "../framework/profiler.h"
 #include "rect.h"
+#include "../framework/sweep.h"
 
 
-Circle::~Circle() {
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
-}
-
 void Circle::setUniforms() const {
     Shape::setUniforms(); // Sets model and shapeColor uniforms
     shader.setFloat("radius", radius);
@@ -14,12 +11,16 @@ void Circle::setUniforms() const {
 }
 
 void Circle::draw() const {
-    glBindVertexArray(VAO);
-    glDrawArrays(GL_TRIANGLE_FAN, 0, segments + 2); // +2 for center and last vertex
+    glBindVertexArray(geometry->VAO);
+    glDrawArrays(GL_TRIANGLE_FAN, 0, geometry->vertexCount); // segments + 2 for center and last vertex
+    Profiler::countDrawCall();
     glBindVertexArray(0);
 }
 
-void Circle::initVectors() {
+void Circle::initVectors(vector<float> &vertices, vector<unsigned int> &indices) {
+    // Unit diameter, so the model matrix's scale by size gives the real radius
+    const float radius = 0.5f;
+
     // Center of circle
     vertices.push_back(0.0f);
     vertices.push_back(0.0f);
@@ -76,4 +77,136 @@ void Circle::bounce(Circle &other) {
         this->setVelocity(thisVelocity - (2 * otherMass / totalMass) * collisionNormal);
         other.setVelocity(otherVelocity + (2 * thisMass / totalMass) * collisionNormal);
     }
-}
\ No newline at end of file
+}
+
+void Circle::resolveCollisions(vector<std::unique_ptr<Circle>> &circles, SpatialHash &hash) {
+    // Forget circles removed since the last call, their ids would index past the end
+    hash.truncate(circles.size());
+    for (unsigned int i = 0; i < circles.size(); i++)
+        hash.update(i, *circles[i]);
+
+    // Only circles whose bounding boxes overlap can be touching
+    for (const auto &pair : hash.findPairs()) {
+        Circle &a = *circles[pair.first];
+        Circle &b = *circles[pair.second];
+        if (a.isOverlapping(b))
+            a.bounce(b);
+    }
+}
+
+void Circle::advance(vector<std::unique_ptr<Circle>> &circles, SpatialHash &hash, float deltaTime, vec2 bounds) {
+    size_t count = circles.size();
+    vector<glm::dvec2> positions(count), velocities(count);
+    vector<double> radii(count), masses(count), speedLimits(count), times(count, 0);
+
+    // Broad phase on the area each circle can sweep through this step
+    hash.truncate(count);
+    for (unsigned int i = 0; i < count; i++) {
+        positions[i] = glm::dvec2(circles[i]->getPos());
+        velocities[i] = glm::dvec2(circles[i]->getVelocity());
+        radii[i] = circles[i]->getRadius();
+        masses[i] = radii[i] * radii[i] * M_PI;
+        speedLimits[i] = glm::length(velocities[i]);
+
+        double reach = radii[i] + speedLimits[i] * deltaTime;
+        hash.update(i, positions[i].x - reach, positions[i].x + reach, positions[i].y - reach, positions[i].y + reach);
+    }
+    vector<vector<unsigned int>> neighbors(count);
+    for (const auto &pair : hash.findPairs()) {
+        neighbors[pair.first].push_back(pair.second);
+        neighbors[pair.second].push_back(pair.first);
+    }
+
+    auto advanceTo = [&](unsigned int i, double time) {
+        positions[i] += velocities[i] * (time - times[i]);
+        times[i] = time;
+    };
+
+    CollisionQueue queue;
+    queue.reset(count);
+    auto schedule = [&](unsigned int i) {
+        double now = times[i];
+        for (int axis = 0; axis < 2; axis++) {
+            double time = now + timeToWall(positions[i][axis], velocities[i][axis], radii[i], bounds[axis] - radii[i]);
+            if (time <= deltaTime)
+                queue.push(time, i, CollisionQueue::WALL, axis);
+        }
+        for (unsigned int j : neighbors[i]) {
+            // Bring the other circle to the same moment before sweeping
+            glm::dvec2 other = positions[j] + velocities[j] * (now - times[j]);
+            double time;
+            if (sweepCircles(positions[i], velocities[i], radii[i], other, velocities[j], radii[j], deltaTime - now, time))
+                queue.push(now + time, i, j);
+        }
+    };
+
+    // A collision can speed a circle up beyond what the broad phase allowed for; look its new path up in the hash
+    vector<unsigned int> found;
+    vector<unsigned int> visited(count, 0);
+    unsigned int visitStamp = 0;
+    auto widen = [&](unsigned int i) {
+        double speed = glm::length(velocities[i]);
+        if (speed <= speedLimits[i])
+            return;
+        speedLimits[i] = speed;
+        double reach = radii[i] + speed * (deltaTime - times[i]);
+        hash.update(i, positions[i].x - reach, positions[i].x + reach, positions[i].y - reach, positions[i].y + reach);
+        hash.query(positions[i].x - reach, positions[i].x + reach, positions[i].y - reach, positions[i].y + reach, found);
+
+        // Skip the circles already listed (lists are symmetric), so schedule() doesn't sweep the same pair twice
+        visitStamp++;
+        visited[i] = visitStamp;
+        for (unsigned int j : neighbors[i])
+            visited[j] = visitStamp;
+        for (unsigned int j : found) {
+            if (visited[j] != visitStamp) {
+                neighbors[i].push_back(j);
+                neighbors[j].push_back(i);
+            }
+        }
+    };
+
+    for (unsigned int i = 0; i < count; i++)
+        schedule(i);
+
+    // Handle impacts earliest first; the cap stops circles wedged together from spinning forever at one instant
+    size_t maxEvents = 16 * count + 16, events = 0;
+    CollisionQueue::Event event;
+    while (events < maxEvents && queue.pop(event) && event.time <= deltaTime) {
+        events++;
+        unsigned int a = event.a, b = event.b;
+        advanceTo(a, event.time);
+        queue.touch(a);
+
+        if (b == CollisionQueue::WALL) {
+            int axis = event.axis;
+            positions[a][axis] = velocities[a][axis] > 0 ? bounds[axis] - radii[a] : radii[a];
+            velocities[a][axis] = -velocities[a][axis];
+            schedule(a);
+            continue;
+        }
+
+        advanceTo(b, event.time);
+        queue.touch(b);
+
+        // Velocity calculations for elastic collision (as in bounce()), at the moment the circles touch
+        glm::dvec2 delta = positions[b] - positions[a];
+        double totalMass = masses[a] + masses[b];
+        glm::dvec2 velocityDifference = velocities[a] - velocities[b];
+        double dotProduct = glm::dot(velocityDifference, delta) / glm::dot(delta, delta);
+        glm::dvec2 collisionNormal = dotProduct * delta;
+        velocities[a] -= (2 * masses[b] / totalMass) * collisionNormal;
+        velocities[b] += (2 * masses[a] / totalMass) * collisionNormal;
+
+        widen(a);
+        widen(b);
+        schedule(a);
+        schedule(b);
+    }
+
+    for (unsigned int i = 0; i < count; i++) {
+        advanceTo(i, deltaTime);
+        circles[i]->setPos(vec2(positions[i]));
+        circles[i]->setVelocity(vec2(velocities[i]));
+    }
+}
@@ -1,7 +1,9 @@
 #ifndef GRAPHICS_CIRCLE_H
 #define GRAPHICS_CIRCLE_H
 
+#include <memory>
 #include "shape.h"
+#include "spatialHash.h"
 #include "../framework/shader.h"
 using std::vector, glm::vec2, glm::vec3, glm::normalize, glm::dot;
 
@@ -23,9 +25,7 @@ public:
     /// @details All other constructors call this constructor.
     Circle(Shader &shader, vec2 pos, vec2 size, vec2 velocity, vec4 color)
         : Shape(shader, pos, size, velocity, color), radius(size.x / 2.0f), velocity(velocity) {
-        initVectors();
-        initVAO();
-        initVBO();
+        geometry = &GeometryCache::get(ShapeType::Circle, segments, Circle::initVectors);
     }
 
     Circle(Shader & shader, vec2 pos, vec2 size, struct color color)
@@ -41,15 +41,13 @@ public:
     // override setUniforms to set the radius uniform
     void setUniforms() const override;
 
-    /// @brief Destroy the Circle object
-    /// @details destroys the VAO and VBO associated with the circle
-    ~Circle() override;
-
     /// @brief Draws the circle
     void draw() const override;
 
-    /// @brief Computes the border of the circle, and stores the vertices in the circleVertices array.
-    void initVectors();
+    /// @brief Computes the border of a unit-diameter circle (a triangle fan with no indices).
+    /// @details Used by the GeometryCache the first time a Circle with this segment count is created.
+    /// The model matrix scales it up to the circle's size.
+    static void initVectors(vector<float> &vertices, vector<unsigned int> &indices);
 
     /// @brief Returns the radius of the circle
     float getRadius() const;
@@ -76,6 +74,24 @@ public:
     /// @brief Handles the collision between two circles
     /// @details This function is called when two circles are overlapping (in Engine's update function).
     void bounce(Circle &other);
+
+    /// @brief Bounces every pair of overlapping circles, testing only the candidate pairs from a spatial hash
+    /// @details Each circle is updated in hash under its index first, so keep the same hash from frame to frame
+    /// and only circles that crossed into another cell cost more than a comparison.
+    /// @param circles The circles to collide
+    /// @param hash The spatial hash holding the circles (ids are indices into circles)
+    static void resolveCollisions(vector<std::unique_ptr<Circle>> &circles, SpatialHash &hash);
+
+    /// @brief Moves every circle by velocity * deltaTime, bouncing off the walls and each other in time order
+    /// @details Continuous collision detection: candidates come from hash using each circle's swept bounds, the time of
+    /// every impact is found with a swept-circle test, and impacts are handled earliest first (see CollisionQueue), so
+    /// fast circles can't pass through each other or the walls between frames. The response is the same elastic
+    /// collision as bounce(), applied at the moment of contact.
+    /// @param circles The circles to move (their velocities change as they bounce)
+    /// @param hash The spatial hash holding the circles (ids are indices into circles)
+    /// @param deltaTime Length of the step in seconds
+    /// @param bounds Width and height of the box the circles bounce in (from (0, 0))
+    static void advance(vector<std::unique_ptr<Circle>> &circles, SpatialHash &hash, float deltaTime, vec2 bounds);
 };
 
 
@@ -0,0 +1,55 @@
+#include "geometryCache.h"
+
+std::map<std::pair<ShapeType, unsigned int>, Geometry> GeometryCache::geometries;
+
+const Geometry& GeometryCache::get(ShapeType type, unsigned int segments, GeometryBuilder builder) {
+    auto key = std::make_pair(type, segments);
+    auto iter = geometries.find(key);
+    if (iter != geometries.end())
+        return iter->second;
+
+    // First request for this shape: build the unit geometry and upload it once
+    vector<float> vertices;
+    vector<unsigned int> indices;
+    builder(vertices, indices);
+    return geometries[key] = upload(vertices, indices);
+}
+
+void GeometryCache::clear() {
+    for (const auto& iter : geometries) {
+        glDeleteVertexArrays(1, &iter.second.VAO);
+        glDeleteBuffers(1, &iter.second.VBO);
+        if (iter.second.EBO != 0)
+            glDeleteBuffers(1, &iter.second.EBO);
+    }
+    geometries.clear();
+}
+
+Geometry GeometryCache::upload(const vector<float> &vertices, const vector<unsigned int> &indices) {
+    Geometry geometry = {0, 0, 0, static_cast<unsigned int>(vertices.size() / 2),
+                         static_cast<unsigned int>(indices.size())};
+
+    // Generate VAO and bind it
+    glGenVertexArrays(1, &geometry.VAO);
+    glBindVertexArray(geometry.VAO);
+
+    // Generate VBO, bind it to VAO, and copy vertices data into it
+    glGenBuffers(1, &geometry.VBO);
+    glBindBuffer(GL_ARRAY_BUFFER, geometry.VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+
+    // Set the vertex attribute pointers (2 floats per vertex (x, y))
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0); // Enable the vertex attribute at location 0
+
+    // Generate EBO (only for indexed shapes); it stays bound to the VAO
+    if (!indices.empty()) {
+        glGenBuffers(1, &geometry.EBO);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geometry.EBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0); // Unbind VBO
+    return geometry;
+}
@@ -0,0 +1,51 @@
+#ifndef GRAPHICS_GEOMETRYCACHE_H
+#define GRAPHICS_GEOMETRYCACHE_H
+
+#include <map>
+#include <utility>
+#include <vector>
+#include <glad/glad.h>
+
+using std::vector;
+
+/// @brief The kinds of shape geometry stored in the GeometryCache.
+enum class ShapeType { Rect, Triangle, Circle };
+
+/// @brief GPU buffers for one unit-sized shape, shared by every instance of that shape.
+struct Geometry {
+    /// @brief The Vertex Array Object, Vertex Buffer Object, and Element Buffer Object (0 if unindexed)
+    unsigned int VAO, VBO, EBO;
+    /// @brief Number of vertices in the VBO
+    unsigned int vertexCount;
+    /// @brief Number of indices in the EBO (0 if unindexed)
+    unsigned int indexCount;
+};
+
+/// @brief Fills in the vertices (x, y pairs) and indices of a unit-sized shape.
+typedef void (*GeometryBuilder)(vector<float> &vertices, vector<unsigned int> &indices);
+
+/// @brief Creates each shape's buffers once and hands the same buffers to every instance.
+/// @details Geometry is keyed by shape type and, for circles, segment count. Shapes scale and position
+/// the unit geometry with their model matrix, so an instance only carries its transform and color.
+class GeometryCache {
+public:
+    /// @brief Returns the geometry for a shape, building it with builder the first time it is requested
+    /// @param type The shape type
+    /// @param segments Segment count for circles (0 for other shapes)
+    /// @param builder Fills in the vertices and indices of the unit-sized shape
+    /// @return The cached geometry (the reference stays valid until clear() is called)
+    static const Geometry& get(ShapeType type, unsigned int segments, GeometryBuilder builder);
+
+    /// @brief Deletes every cached VAO, VBO and EBO
+    /// @note Call this while the OpenGL context is still current.
+    static void clear();
+
+private:
+    /// @brief A map of geometry, with the key being the shape type and segment count
+    static std::map<std::pair<ShapeType, unsigned int>, Geometry> geometries;
+
+    /// @brief Uploads vertices and indices into a new VAO/VBO/EBO
+    static Geometry upload(const vector<float> &vertices, const vector<unsigned int> &indices);
+};
+
+#endif //GRAPHICS_GEOMETRYCACHE_H
@@ -1,11 +1,9 @@
 #include "rect.h"
+#include "../framework/profiler.h"
 #include "circle.h"
 
 Rect::Rect(Shader & shader, vec2 pos, vec2 size, vec2 velocity, struct color color) : Shape(shader, pos, size, velocity, color) {
-    initVectors();
-    initVAO();
-    initVBO();
-    initEBO();
+    geometry = &GeometryCache::get(ShapeType::Rect, 0, Rect::initVectors);
 }
 
 //Rect::Rect(Shader &shader, vec2 pos, float width, struct color color)
@@ -14,26 +12,22 @@ Rect::Rect(Shader & shader, vec2 pos, vec2 size, vec2 velocity, struct color col
 //Rect::Rect(Shader &shader, vec2 pos, float width, vec4 color)
 //    : Rect(shader, pos, vec2(width, width), color) {}
 
-Rect::~Rect() {
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
-}
-
 void Rect::draw() const {
-    glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    glBindVertexArray(geometry->VAO);
+    glDrawElements(GL_TRIANGLES, geometry->indexCount, GL_UNSIGNED_INT, 0);
+    Profiler::countDrawCall();
     glBindVertexArray(0);
 }
 
-void Rect::initVectors() {
-    this->vertices.insert(vertices.end(), {
+void Rect::initVectors(vector<float> &vertices, vector<unsigned int> &indices) {
+    vertices.insert(vertices.end(), {
         -0.5f, 0.5f,   // Top left
         0.5f, 0.5f,   // Top right
         -0.5f, -0.5f,  // Bottom left
         0.5f, -0.5f   // Bottom right
     });
 
-    this->indices.insert(indices.end(), {
+    indices.insert(indices.end(), {
         0, 1, 2, // First triangle
         1, 2, 3  // Second triangle
     });
@@ -8,12 +8,9 @@ using glm::vec2, glm::vec3;
 
 
 class Rect : public Shape {
-private:
-    /// @brief Initializes the vertices and indices of the square
-    void initVectors();
 public:
     /// @brief Construct a new Square object
-    /// @details This constructor will call the InitRenderData function.
+    /// @details This constructor looks up the shared unit-square geometry in the GeometryCache.
     /// @param shader The shader to use
     /// @param pos The position of the square
     /// @param size The size of the square
@@ -28,9 +25,6 @@ public:
 
     Rect(Rect const& other);
 
-    /// @brief Destroy the Square object and delete it's VAO and VBO
-    ~Rect();
-
     /// @brief Binds the VAO and calls the virtual draw function
     void draw() const override;
 
@@ -38,6 +32,10 @@ public:
     float getRight() const override;
     float getTop() const override;
     float getBottom() const override;
+
+    /// @brief Fills in the vertices and indices of the unit square
+    /// @details Used by the GeometryCache the first time a Rect is created.
+    static void initVectors(vector<float> &vertices, vector<unsigned int> &indices);
 };
 
 
@@ -10,34 +10,6 @@ Shape::Shape(Shader &shader, glm::vec2 pos, vec2 size, vec2 velocity, vec4 color
     shader(shader), pos(pos), size(size), velocity(velocity), color(color) {}
 
 
-// Initialize VAO
-unsigned int Shape::initVAO() {
-    glGenVertexArrays(1, &VAO); // Generate VAO
-    glBindVertexArray(VAO); // Bind VAO
-    return VAO;
-}
-
-// Initialize VBO
-void Shape::initVBO() {
-    // Generate VBO, bind it to VAO, and copy vertices data into it
-    glGenBuffers(1, &VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-
-    // Set the vertex attribute pointers (2 floats per vertex (x, y))
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0); // Enable the vertex attribute at location 0
-    glBindBuffer(GL_ARRAY_BUFFER, 0); // Unbind VBO
-}
-
-// Initialize EBO
-void Shape::initEBO() {
-    glGenBuffers(1, &EBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(float), indices.data(), GL_STATIC_DRAW);
-    // Don't unbind EBO because it's bound to VAO
-}
-
 void Shape::setUniforms() const {
     // If you want to use a custom shader, you have to set it and call it's Use() function here.
     // Since we are using the same shader for all shapes, we can just set it once in the constructor.
@@ -5,6 +5,7 @@
 #include <vector>
 #include "../framework/shader.h"
 #include "../framework/color.h"
+#include "geometryCache.h"
 
 using std::vector, glm::vec2, glm::vec3, glm::vec4, glm::mat4, glm::translate, glm::scale;
 
@@ -25,23 +26,6 @@ class Shape {
         /// @brief Destroy the Shape object
         virtual ~Shape() = default;
 
-        // --------------------------------------------------------
-        // Initialization functions
-        // --------------------------------------------------------
-
-        /// @brief Initializes the VAO.
-        /// @details This function is called in the derived classes' constructor.
-        unsigned int initVAO();
-
-        /// @brief Initializes the VBO.
-        /// @details This function is called in the derived classes' constructor.
-        void initVBO();
-
-        /// @brief Initializes the EBO.
-        /// @details This function is called in the derived classes' constructor.
-        /// @details If function has no indices, pass nullptr for indices and 0 for indexCount.
-        void initEBO();
-
         // --------------------------------------------------------
         // Getters
         // --------------------------------------------------------
@@ -130,14 +114,9 @@ protected:
         /// @brief The VAO of the shape
         color color;
 
-        /// @brief The Vertex Array Object, Vertex Buffer Object, and Element Buffer Object of the shape.
-        unsigned int VAO, VBO, EBO;
-
-        /// @brief The vertices of the shape
-        vector<float> vertices;
-
-        /// @brief The indices of the shape
-        vector<unsigned int> indices;
+        /// @brief The unit-sized geometry (VAO, VBO and EBO) shared by every shape of this type.
+        /// @details Set by the derived classes' constructor from the GeometryCache.
+        const Geometry *geometry = nullptr;
 };
 
 #endif //GRAPHICS_SHAPE_H
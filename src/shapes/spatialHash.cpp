@@ -0,0 +1,152 @@
+#include "spatialHash.h"
+
+#include <cmath>
+
+SpatialHash::SpatialHash(float cellSize) : cellSize(cellSize) {}
+
+void SpatialHash::update(unsigned int id, const Shape &shape) {
+    update(id, shape.getLeft(), shape.getRight(), shape.getBottom(), shape.getTop());
+}
+
+void SpatialHash::update(unsigned int id, float left, float right, float bottom, float top) {
+    if (id >= entries.size())
+        entries.resize(id + 1, Entry{0, 0, 0, 0, 0, -1, 0, -1, false});
+
+    Entry &entry = entries[id];
+    Entry moved = {left, right, bottom, top, cellOf(left), cellOf(right), cellOf(bottom), cellOf(top), true};
+
+    // Still in the same cells: only the bounds change
+    if (entry.present && moved.minX == entry.minX && moved.maxX == entry.maxX &&
+        moved.minY == entry.minY && moved.maxY == entry.maxY) {
+        entry = moved;
+        return;
+    }
+
+    if (entry.present)
+        removeFromCells(id, entry);
+    else
+        count++;
+    entry = moved;
+    addToCells(id, entry);
+}
+
+void SpatialHash::remove(unsigned int id) {
+    if (id >= entries.size() || !entries[id].present)
+        return;
+    removeFromCells(id, entries[id]);
+    entries[id].present = false;
+    count--;
+}
+
+void SpatialHash::truncate(size_t count) {
+    for (size_t id = count; id < entries.size(); id++)
+        remove(id);
+    if (entries.size() > count)
+        entries.resize(count);
+}
+
+void SpatialHash::clear() {
+    entries.clear();
+    cells.clear();
+    cellIndex.clear();
+    count = 0;
+}
+
+void SpatialHash::findPairs(vector<std::pair<unsigned int, unsigned int>> &pairs) const {
+    pairs.clear();
+    for (const Cell &cell : cells) {
+        const vector<unsigned int> &ids = cell.ids;
+        for (size_t i = 0; i + 1 < ids.size(); i++) {
+            const Entry &a = entries[ids[i]];
+            for (size_t j = i + 1; j < ids.size(); j++) {
+                const Entry &b = entries[ids[j]];
+
+                // Shapes spanning several cells meet in more than one; only report the pair from the lowest shared cell
+                int firstX = a.minX > b.minX ? a.minX : b.minX;
+                int firstY = a.minY > b.minY ? a.minY : b.minY;
+                if (firstX != cell.x || firstY != cell.y || !overlaps(a, b))
+                    continue;
+
+                if (ids[i] < ids[j])
+                    pairs.emplace_back(ids[i], ids[j]);
+                else
+                    pairs.emplace_back(ids[j], ids[i]);
+            }
+        }
+    }
+}
+
+const vector<std::pair<unsigned int, unsigned int>> &SpatialHash::findPairs() {
+    findPairs(pairs);
+    return pairs;
+}
+
+void SpatialHash::query(float left, float right, float bottom, float top, vector<unsigned int> &ids) const {
+    ids.clear();
+    Entry box = {left, right, bottom, top, cellOf(left), cellOf(right), cellOf(bottom), cellOf(top), true};
+
+    for (int x = box.minX; x <= box.maxX; x++) {
+        for (int y = box.minY; y <= box.maxY; y++) {
+            auto iter = cellIndex.find(key(x, y));
+            if (iter == cellIndex.end())
+                continue;
+
+            for (unsigned int id : cells[iter->second].ids) {
+                // Report each shape from the first cell it shares with the box only
+                const Entry &entry = entries[id];
+                int firstX = entry.minX > box.minX ? entry.minX : box.minX;
+                int firstY = entry.minY > box.minY ? entry.minY : box.minY;
+                if (firstX == x && firstY == y && overlaps(entry, box))
+                    ids.push_back(id);
+            }
+        }
+    }
+}
+
+size_t SpatialHash::size() const {
+    return count;
+}
+
+int SpatialHash::cellOf(float value) const {
+    return static_cast<int>(std::floor(value / cellSize));
+}
+
+uint64_t SpatialHash::key(int x, int y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+void SpatialHash::addToCells(unsigned int id, const Entry &entry) {
+    for (int x = entry.minX; x <= entry.maxX; x++) {
+        for (int y = entry.minY; y <= entry.maxY; y++) {
+            auto inserted = cellIndex.emplace(key(x, y), cells.size());
+            if (inserted.second)
+                cells.push_back({x, y, {}});
+            cells[inserted.first->second].ids.push_back(id);
+        }
+    }
+}
+
+void SpatialHash::removeFromCells(unsigned int id, const Entry &entry) {
+    for (int x = entry.minX; x <= entry.maxX; x++) {
+        for (int y = entry.minY; y <= entry.maxY; y++) {
+            auto iter = cellIndex.find(key(x, y));
+            if (iter == cellIndex.end())
+                continue;
+
+            // Swap and pop; the order within a cell doesn't matter
+            vector<unsigned int> &ids = cells[iter->second].ids;
+            for (size_t i = 0; i < ids.size(); i++) {
+                if (ids[i] == id) {
+                    ids[i] = ids.back();
+                    ids.pop_back();
+                    break;
+                }
+            }
+            // Keep the (emptied) cell so a shape moving back doesn't reallocate it
+        }
+    }
+}
+
+bool SpatialHash::overlaps(const Entry &a, const Entry &b) {
+    return a.left < b.right && b.left < a.right && a.bottom < b.top && b.bottom < a.top;
+}
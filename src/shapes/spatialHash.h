@@ -0,0 +1,109 @@
+#ifndef GRAPHICS_SPATIALHASH_H
+#define GRAPHICS_SPATIALHASH_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "shape.h"
+
+using std::vector;
+
+/**
+ * @brief A uniform grid over shape bounding boxes that finds candidate collision pairs
+ * @details Shapes are registered under a caller-chosen id (usually their index) with the bounds from
+ * Shape::getLeft/getRight/getTop/getBottom. Each one is stored in every grid cell its bounds touch; the cells live
+ * in a hash map, so the grid has no fixed extent. Only shapes sharing a cell are compared, which makes finding
+ * pairs close to linear when the cells are about the size of the shapes.
+ *
+ * The hash is meant to be updated, not rebuilt, every frame: update() only touches the cell lists when a shape
+ * has crossed into different cells, which most shapes haven't.
+ */
+class SpatialHash {
+    public:
+        /// @brief Construct a new Spatial Hash object
+        /// @param cellSize Width and height of a cell (around the diameter of a typical shape works best)
+        explicit SpatialHash(float cellSize);
+
+        /// @brief Adds a shape, or moves it if the id is already present
+        /// @param id The id to report the shape under
+        /// @param shape The shape whose bounds to store
+        void update(unsigned int id, const Shape &shape);
+
+        /// @brief Adds or moves a bounding box under id
+        void update(unsigned int id, float left, float right, float bottom, float top);
+
+        /// @brief Removes the shape stored under id (if any)
+        void remove(unsigned int id);
+
+        /// @brief Removes every shape whose id is count or more
+        /// @details For callers that use indices as ids: call it with the current number of shapes so the ones
+        /// removed since the last frame stop being reported.
+        void truncate(size_t count);
+
+        /// @brief Removes every shape
+        void clear();
+
+        /// @brief Collects every pair of ids whose bounding boxes overlap, each pair once
+        /// @param pairs Cleared, then filled with (smaller id, larger id) pairs
+        void findPairs(vector<std::pair<unsigned int, unsigned int>> &pairs) const;
+
+        /// @brief Collects every overlapping pair into a buffer kept by the hash, so it is only allocated once
+        /// @return The (smaller id, larger id) pairs, valid until the next call
+        const vector<std::pair<unsigned int, unsigned int>> &findPairs();
+
+        /// @brief Collects the id of every shape whose bounding box overlaps the given box
+        /// @param ids Cleared, then filled with the ids (each once)
+        void query(float left, float right, float bottom, float top, vector<unsigned int> &ids) const;
+
+        /// @brief Returns the number of shapes stored
+        size_t size() const;
+
+    private:
+        /// @brief The bounding box and cell range of a stored shape
+        struct Entry {
+            float left, right, bottom, top;
+            int minX, maxX, minY, maxY;
+            bool present;
+        };
+
+        /// @brief Width and height of a cell
+        float cellSize;
+
+        /// @brief The stored shapes, indexed by id
+        vector<Entry> entries;
+
+        /// @brief Number of entries that are present
+        size_t count = 0;
+
+        /// @brief A grid cell and the ids of the shapes touching it
+        struct Cell {
+            int x, y;
+            vector<unsigned int> ids;
+        };
+
+        /// @brief Every cell that has been used, stored contiguously so findPairs() can walk them in order
+        vector<Cell> cells;
+
+        /// @brief Index into cells for each cell's hash key
+        std::unordered_map<uint64_t, unsigned int> cellIndex;
+
+        /// @brief The pairs found by the last call to findPairs()
+        vector<std::pair<unsigned int, unsigned int>> pairs;
+
+        /// @brief Returns the cell coordinate a position falls in
+        int cellOf(float value) const;
+
+        /// @brief Packs a cell's coordinates into its hash map key
+        static uint64_t key(int x, int y);
+
+        /// @brief Adds or removes id in every cell of its entry's range
+        void addToCells(unsigned int id, const Entry &entry);
+        void removeFromCells(unsigned int id, const Entry &entry);
+
+        /// @brief Checks if two bounding boxes overlap
+        static bool overlaps(const Entry &a, const Entry &b);
+};
+
+#endif //GRAPHICS_SPATIALHASH_H
@@ -1,34 +1,27 @@
 #include "triangle.h"
+#include "../framework/profiler.h"
 
 Triangle::Triangle(Shader & shader, vec2 pos, vec2 size, struct color color)
-    : Shape(shader, pos, size, velocity, color) {
-    // Check if a triangle has been initialized
-    initVectors();
-    initVAO();
-    initVBO();
-    initEBO();
-}
-
-Triangle::~Triangle() {
-    glDeleteVertexArrays(1, &this->VAO);
-    glDeleteBuffers(1, &VBO);
-    glDeleteBuffers(1, &EBO);
+    : Shape(shader, pos, size, vec2(0, 0), color) {
+    // Every triangle shares the same unit geometry
+    geometry = &GeometryCache::get(ShapeType::Triangle, 0, Triangle::initVectors);
 }
 
 void Triangle::draw() const {
-    glBindVertexArray(this->VAO);
-    glDrawElements(GL_TRIANGLES, 3, GL_UNSIGNED_INT, 0);
+    glBindVertexArray(geometry->VAO);
+    glDrawElements(GL_TRIANGLES, geometry->indexCount, GL_UNSIGNED_INT, 0);
+    Profiler::countDrawCall();
     glBindVertexArray(0);
 }
 
-void Triangle::initVectors() {
-    this->vertices.insert(this->vertices.end(), {
+void Triangle::initVectors(vector<float> &vertices, vector<unsigned int> &indices) {
+    vertices.insert(vertices.end(), {
             -0.5f, -0.5f,  // Bottom left
             0.5f, -0.5f,   // Bottom right
             0.0f, 0.5f     // Top
     });
 
-    this->indices.insert(this->indices.end(), {
+    indices.insert(indices.end(), {
             0, 1, 2,
     });
 }
\ No newline at end of file
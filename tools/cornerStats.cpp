@@ -0,0 +1,194 @@
+// Monte Carlo corner statistics.
+// Samples random start conditions (window size, logo size, position and velocity), runs each one through the
+// same fixed-tick Simulation the screensaver uses, spread across all cores, and prints the distributions of
+// time to first corner and corners per hour.
+//
+//   cmake --build build --target corner_stats && ./build/corner_stats --samples 2000 --hours 1
+
+#include "../src/framework/simulation.h"
+#include "../src/framework/jobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using std::vector, std::cout, std::endl;
+
+/// @brief Options for a run, read from the command line
+struct StatsConfig {
+    size_t samples = 1000;
+    double hours = 1;
+    float tickRate = 60;
+    unsigned int seed = 1;
+    bool eventStepping = false;
+    std::string csvPath;
+};
+
+/// @brief One start condition
+struct Sample {
+    vec2 bounds;
+    Logo logo;
+};
+
+/// @brief What happened to one sample
+struct SampleResult {
+    /// @brief Seconds until the first corner (negative if there was none)
+    double firstCorner;
+    double cornersPerHour;
+};
+
+static void printUsage(const char *program) {
+    cout << "Usage: " << program << " [options]\n"
+         << "  --samples <n>         Number of random start conditions (default 1000)\n"
+         << "  --hours <h>           Simulated hours per sample (default 1)\n"
+         << "  --tick-rate <n>       Simulation ticks per second (default 60)\n"
+         << "  --seed <n>            Random seed (default 1)\n"
+         << "  --event-step          Use exact time-of-impact stepping instead of the on-screen clamp rules\n"
+         << "  --csv <file>          Also write every sample and its result to <file>\n"
+         << "  --help                Show this message" << endl;
+}
+
+/// @brief Fills in config from the command line; help is set if --help was given (which also returns false)
+static bool parseArguments(int argc, char *argv[], StatsConfig &config, bool &help) {
+    help = false;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (std::strcmp(arg, "--samples") == 0 && hasValue) {
+            config.samples = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--hours") == 0 && hasValue) {
+            config.hours = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(arg, "--tick-rate") == 0 && hasValue) {
+            config.tickRate = std::strtof(argv[++i], nullptr);
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            config.seed = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--event-step") == 0) {
+            config.eventStepping = true;
+        } else if (std::strcmp(arg, "--csv") == 0 && hasValue) {
+            config.csvPath = argv[++i];
+        } else if (std::strcmp(arg, "--help") == 0) {
+            help = true;
+            return false;
+        } else {
+            cout << "ERROR::ARGUMENTS: Unknown or incomplete option: " << arg << endl;
+            return false;
+        }
+    }
+    return config.samples > 0 && config.hours > 0 && config.tickRate > 0;
+}
+
+/// @brief Draws the start conditions up front on one thread, so results don't depend on the thread count
+static vector<Sample> drawSamples(const StatsConfig &config) {
+    std::mt19937 rng(config.seed);
+    std::uniform_real_distribution<float> width(400, 1920), height(300, 1080), unit(0, 1);
+    std::uniform_real_distribution<double> speed(50, 300);
+
+    vector<Sample> samples(config.samples);
+    for (Sample &sample : samples) {
+        sample.bounds = vec2(std::round(width(rng)), std::round(height(rng)));
+
+        // Logos between 5% and 25% of the window
+        vec2 size = sample.bounds * (0.05f + 0.2f * unit(rng));
+        sample.logo.size = vec2(std::round(size.x), std::round(size.y));
+
+        vec2 low = sample.logo.size / 2.0f, high = sample.bounds - sample.logo.size / 2.0f;
+        sample.logo.pos = dvec2(low.x + unit(rng) * (high.x - low.x), low.y + unit(rng) * (high.y - low.y));
+        sample.logo.velocity = dvec2(unit(rng) < 0.5f ? -speed(rng) : speed(rng),
+                                     unit(rng) < 0.5f ? -speed(rng) : speed(rng));
+    }
+    return samples;
+}
+
+/// @brief Runs one sample tick by tick, exactly as the screensaver would
+static SampleResult runSample(const Sample &sample, const StatsConfig &config) {
+    Simulation simulation(sample.bounds, sample.logo, config.eventStepping ? StepMode::Event : StepMode::Clamp);
+    float tickTime = 1.0f / config.tickRate;
+    auto ticks = static_cast<unsigned long long>(config.hours * 3600 * config.tickRate);
+
+    SampleResult result = {-1, 0};
+    for (unsigned long long tick = 0; tick < ticks; tick++) {
+        if (simulation.step(tickTime) > 0 && result.firstCorner < 0)
+            result.firstCorner = (tick + 1) * double(tickTime);
+    }
+    result.cornersPerHour = simulation.getCornersHit() / config.hours;
+    return result;
+}
+
+/// @brief Returns the p-th percentile (0-100) of sorted values
+static double percentile(const vector<double> &sorted, double p) {
+    if (sorted.empty())
+        return 0;
+    double rank = p / 100 * (sorted.size() - 1);
+    size_t below = static_cast<size_t>(rank);
+    size_t above = below + 1 < sorted.size() ? below + 1 : below;
+    return sorted[below] + (sorted[above] - sorted[below]) * (rank - below);
+}
+
+static void printDistribution(const char *name, vector<double> values) {
+    std::sort(values.begin(), values.end());
+    double sum = 0;
+    for (double value : values)
+        sum += value;
+
+    cout << name << " (" << values.size() << " samples)\n";
+    if (values.empty())
+        return;
+    cout << "  mean " << sum / values.size() << ", min " << values.front() << ", max " << values.back() << "\n";
+    for (double p : {10, 25, 50, 75, 90, 99})
+        cout << "  p" << p << " " << percentile(values, p) << "\n";
+}
+
+int main(int argc, char *argv[]) {
+    StatsConfig config;
+    bool help;
+    if (!parseArguments(argc, argv, config, help)) {
+        printUsage(argv[0]);
+        return help ? 0 : 1;
+    }
+
+    vector<Sample> samples = drawSamples(config);
+    vector<SampleResult> results(samples.size());
+
+    // Every sample is independent, so hand them out in small chunks and let the workers steal the slow ones
+    JobSystem jobs;
+    cout << "Running " << samples.size() << " samples of " << config.hours << " h on "
+         << jobs.getWorkerCount() + 1 << " threads..." << endl;
+    jobs.parallelFor(samples.size(), 4, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            results[i] = runSample(samples[i], config);
+    });
+
+    vector<double> firstCorners, cornersPerHour;
+    for (const SampleResult &result : results) {
+        if (result.firstCorner >= 0)
+            firstCorners.push_back(result.firstCorner);
+        cornersPerHour.push_back(result.cornersPerHour);
+    }
+
+    cout << "Samples without a corner: " << samples.size() - firstCorners.size() << "\n";
+    printDistribution("Time to first corner (s)", firstCorners);
+    printDistribution("Corners per hour", cornersPerHour);
+
+    if (!config.csvPath.empty()) {
+        std::ofstream csv(config.csvPath);
+        if (!csv) {
+            cout << "ERROR::CSV: Could not open " << config.csvPath << endl;
+            return 1;
+        }
+        csv << "width,height,logo_width,logo_height,x,y,velocity_x,velocity_y,first_corner,corners_per_hour\n";
+        for (size_t i = 0; i < samples.size(); i++) {
+            const Sample &s = samples[i];
+            csv << s.bounds.x << "," << s.bounds.y << "," << s.logo.size.x << "," << s.logo.size.y << ","
+                << s.logo.pos.x << "," << s.logo.pos.y << "," << s.logo.velocity.x << "," << s.logo.velocity.y << ","
+                << results[i].firstCorner << "," << results[i].cornersPerHour << "\n";
+        }
+    }
+    return 0;
+}